@@ -0,0 +1,83 @@
+# Compile-time and code-size figures for individual translation units.
+#
+#   cpplearn_compile_stats(<target> [NO_TIME] OUTPUT <file.inc> SOURCES <files...>)
+#
+# compiles each source on its own, three times (once with NO_TIME), with
+# the compiler and the compile options, definitions and include directories
+# of <target> (so the cpplearn::options warnings, CPPLEARN_TRACE and
+# sanitizer flags included), and writes one line per source to <file.inc>:
+#
+#   {"<source name without extension>", <compile milliseconds>, <code bytes>, <unwind bytes>},
+#
+# Compile milliseconds is the best user CPU time GCC reports in the TOTAL
+# line of -ftime-report (10 ms resolution).  CPU time rather than wall time,
+# because these compiles run alongside the rest of a parallel build, and
+# wall time would mostly measure how many other jobs shared the machine.
+# With other compilers it is -1, which report_compile_stats() leaves out.
+# NO_TIME is for targets that only report code size: each source is then
+# compiled once, without -ftime-report, and compile milliseconds is -1.
+#
+# Code bytes is the sum of the object's .text*, .rodata* and .data*
+# sections and unwind bytes that of its .eh_frame and .gcc_except_table, as
+# reported by `size -A`.  The file is added to <target>'s sources and its
+# directory to the include path, so the target can #include it inside an
+# array of cpplearn::bench::compile_stat (cpplearn/compile_stats.hpp).
+# Without `size` the file is generated empty.
+#
+# Each compile also writes its dependencies (-MD), which are merged into one
+# depfile for <file.inc>, so editing a header or .inl file a source includes
+# measures again.
+
+find_program(CPPLEARN_SIZE_TOOL size)
+
+function(cpplearn_compile_stats target)
+    cmake_parse_arguments(PARSE_ARGV 1 arg "NO_TIME" "OUTPUT" "SOURCES")
+    set(output ${CMAKE_CURRENT_BINARY_DIR}/${arg_OUTPUT})
+    target_include_directories(${target} PRIVATE ${CMAKE_CURRENT_BINARY_DIR})
+
+    if(NOT CPPLEARN_SIZE_TOOL)
+        file(WRITE ${output} "// compile statistics unavailable\n")
+        target_sources(${target} PRIVATE ${output})
+        return()
+    endif()
+
+    string(TOUPPER "${CMAKE_BUILD_TYPE}" config)
+    separate_arguments(flags UNIX_COMMAND
+        "${CMAKE_CXX_FLAGS} ${CMAKE_CXX_FLAGS_${config}} ${CMAKE_CXX20_STANDARD_COMPILE_OPTION}")
+    set(time_report OFF)
+    if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU" AND NOT arg_NO_TIME)
+        set(time_report ON)
+    endif()
+
+    set(sources "")
+    foreach(source IN LISTS arg_SOURCES)
+        list(APPEND sources ${CMAKE_CURRENT_SOURCE_DIR}/${source})
+    endforeach()
+    # Lists are passed to the script with '|' so they survive as one argument.
+    string(REPLACE ";" "|" flags_arg "${flags}")
+    string(REPLACE ";" "|" sources_arg "${sources}")
+    set(options_arg "$<JOIN:$<TARGET_PROPERTY:${target},COMPILE_OPTIONS>,|>")
+    set(definitions_arg "$<JOIN:$<TARGET_PROPERTY:${target},COMPILE_DEFINITIONS>,|>")
+    set(includes_arg "$<JOIN:$<TARGET_PROPERTY:${target},INCLUDE_DIRECTORIES>,|>")
+
+    add_custom_command(
+        OUTPUT ${output}
+        COMMAND ${CMAKE_COMMAND}
+                -DCOMPILER=${CMAKE_CXX_COMPILER}
+                -DFLAGS=${flags_arg}
+                -DOPTIONS=${options_arg}
+                -DDEFINITIONS=${definitions_arg}
+                -DINCLUDES=${includes_arg}
+                -DTIME_REPORT=${time_report}
+                -DSOURCES=${sources_arg}
+                -DSIZE_TOOL=${CPPLEARN_SIZE_TOOL}
+                -DWORK_DIR=${CMAKE_CURRENT_BINARY_DIR}/compile_stats
+                -DOUTPUT=${output}
+                -DDEPFILE=${output}.d
+                -P ${PROJECT_SOURCE_DIR}/cmake/measure_compile.cmake
+        DEPENDS ${sources} ${PROJECT_SOURCE_DIR}/cmake/measure_compile.cmake
+        DEPFILE ${output}.d
+        COMMENT "Measuring compile time and code size for ${target}"
+        VERBATIM)
+    target_sources(${target} PRIVATE ${output})
+endfunction()
@@ -0,0 +1,59 @@
+# Helpers for declaring snippet executables and the aggregate `bench` target.
+#
+#   cpplearn_add_snippet(<name> SOURCES <files...> [LIBRARIES <libs...>])
+#
+# builds `bench_<name>` from the given sources, linked against the harness
+# (which provides main), and adds a `bench_<name>.run` target that writes
+# ${CMAKE_BINARY_DIR}/bench-results/<name>.<format>.  `bench` runs them all.
+
+add_library(cpplearn_options INTERFACE)
+add_library(cpplearn::options ALIAS cpplearn_options)
+target_compile_options(cpplearn_options INTERFACE
+    $<$<CXX_COMPILER_ID:GNU,Clang>:-Wall -Wextra -Wpedantic>)
+target_compile_definitions(cpplearn_options INTERFACE
+    CPPLEARN_BUILD_TYPE="$<CONFIG>"
+    CPPLEARN_TRACE=$<BOOL:${CPPLEARN_TRACE}>)
+if(CPPLEARN_NATIVE)
+    target_compile_options(cpplearn_options INTERFACE -march=native)
+endif()
+if(CPPLEARN_SANITIZER)
+    target_compile_options(cpplearn_options INTERFACE
+        -fsanitize=${CPPLEARN_SANITIZER} -fno-omit-frame-pointer -g)
+    target_link_options(cpplearn_options INTERFACE -fsanitize=${CPPLEARN_SANITIZER})
+endif()
+
+set_property(GLOBAL PROPERTY CPPLEARN_SNIPPETS "")
+
+function(cpplearn_add_snippet name)
+    cmake_parse_arguments(PARSE_ARGV 1 arg "" "" "SOURCES;LIBRARIES")
+    if(NOT arg_SOURCES)
+        message(FATAL_ERROR "cpplearn_add_snippet(${name}) needs SOURCES")
+    endif()
+
+    set(target bench_${name})
+    add_executable(${target} ${arg_SOURCES})
+    target_link_libraries(${target} PRIVATE cpplearn::bench_main ${arg_LIBRARIES})
+    target_include_directories(${target} PRIVATE ${CMAKE_CURRENT_SOURCE_DIR})
+    set_property(GLOBAL APPEND PROPERTY CPPLEARN_SNIPPETS ${name})
+
+    set(results_dir ${CMAKE_BINARY_DIR}/bench-results)
+    separate_arguments(extra_args UNIX_COMMAND "${CPPLEARN_BENCH_ARGS}")
+    add_custom_target(${target}.run
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${results_dir}
+        COMMAND $<TARGET_FILE:${target}>
+                --format=${CPPLEARN_BENCH_FORMAT}
+                --out=${results_dir}/${name}.${CPPLEARN_BENCH_FORMAT}
+                ${extra_args}
+        DEPENDS ${target}
+        COMMENT "Running snippet benchmark ${name}"
+        USES_TERMINAL
+        VERBATIM)
+endfunction()
+
+function(cpplearn_add_bench_target)
+    get_property(snippets GLOBAL PROPERTY CPPLEARN_SNIPPETS)
+    add_custom_target(bench COMMENT "Benchmark results in ${CMAKE_BINARY_DIR}/bench-results")
+    foreach(name IN LISTS snippets)
+        add_dependencies(bench bench_${name}.run)
+    endforeach()
+endfunction()
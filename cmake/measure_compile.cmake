@@ -0,0 +1,87 @@
+# Script mode helper for cpplearn_compile_stats(); see CppLearnCompileStats.cmake.
+#
+#   cmake -DCOMPILER=... -DFLAGS=a|b -DOPTIONS=a|b -DDEFINITIONS=A=1|B
+#         -DINCLUDES=dir|dir -DTIME_REPORT=ON|OFF -DSOURCES=x.cpp|y.cpp
+#         -DSIZE_TOOL=... -DWORK_DIR=... -DOUTPUT=... -DDEPFILE=...
+#         -P measure_compile.cmake
+
+string(REPLACE "|" ";" flags "${FLAGS}")
+string(REPLACE "|" ";" options "${OPTIONS}")
+string(REPLACE "|" ";" definitions "${DEFINITIONS}")
+string(REPLACE "|" ";" includes "${INCLUDES}")
+string(REPLACE "|" ";" sources "${SOURCES}")
+list(APPEND flags ${options})
+foreach(definition IN LISTS definitions)
+    list(APPEND flags -D${definition})
+endforeach()
+foreach(include IN LISTS includes)
+    list(APPEND flags -I${include})
+endforeach()
+if(TIME_REPORT)
+    list(APPEND flags -ftime-report)
+endif()
+file(MAKE_DIRECTORY ${WORK_DIR})
+
+# Three runs for the best time; without a time report one gives the sizes.
+set(last_run 0)
+if(TIME_REPORT)
+    set(last_run 2)
+endif()
+
+set(lines "")
+set(dependencies "")
+foreach(source IN LISTS sources)
+    get_filename_component(name ${source} NAME_WE)
+    set(object ${WORK_DIR}/${name}.o)
+    set(depfile ${WORK_DIR}/${name}.d)
+
+    # -ftime-report ends with
+    #   TOTAL  :   <user s>   <system s>   <wall s>   <memory>
+    # on stderr.  Only user time counts: most of the system time is the
+    # report's own clock reads, which a plain compile does not make.
+    set(best_ms "")
+    foreach(run RANGE ${last_run})
+        execute_process(
+            COMMAND ${COMPILER} ${flags} -MD -MF ${depfile} -MT ${OUTPUT} -c ${source} -o ${object}
+            RESULT_VARIABLE result
+            ERROR_VARIABLE errors)
+        if(NOT result EQUAL 0)
+            message(FATAL_ERROR "compiling ${source} failed:\n${errors}")
+        endif()
+        if(TIME_REPORT AND errors MATCHES "\n *TOTAL *: *([0-9]+)\\.([0-9][0-9]) ")
+            # Seconds with two decimals; the fraction is read as 1xx - 100 so
+            # that a leading zero cannot upset math().
+            math(EXPR cpu_ms "${CMAKE_MATCH_1} * 1000 + (1${CMAKE_MATCH_2} - 100) * 10")
+            if(best_ms STREQUAL "" OR cpu_ms LESS best_ms)
+                set(best_ms ${cpu_ms})
+            endif()
+        endif()
+    endforeach()
+    if(best_ms STREQUAL "")
+        set(best_ms -1)
+    endif()
+    # Every rule names OUTPUT as its target, so the files concatenate into
+    # one depfile.
+    file(READ ${depfile} rule)
+    string(APPEND dependencies "${rule}")
+
+    execute_process(COMMAND ${SIZE_TOOL} -A ${object} OUTPUT_VARIABLE sections)
+    string(REGEX MATCHALL "\n\\.(text|rodata|data)[^ \t\n]*[ \t]+[0-9]+" matches "${sections}")
+    set(code_bytes 0)
+    foreach(match IN LISTS matches)
+        string(REGEX REPLACE ".*[ \t]([0-9]+)$" "\\1" bytes "${match}")
+        math(EXPR code_bytes "${code_bytes} + ${bytes}")
+    endforeach()
+
+    string(REGEX MATCHALL "\n\\.(eh_frame|gcc_except_table)[^ \t\n]*[ \t]+[0-9]+" matches "${sections}")
+    set(unwind_bytes 0)
+    foreach(match IN LISTS matches)
+        string(REGEX REPLACE ".*[ \t]([0-9]+)$" "\\1" bytes "${match}")
+        math(EXPR unwind_bytes "${unwind_bytes} + ${bytes}")
+    endforeach()
+
+    string(APPEND lines "{\"${name}\", ${best_ms}, ${code_bytes}, ${unwind_bytes}},\n")
+endforeach()
+
+file(WRITE ${OUTPUT} "${lines}")
+file(WRITE ${DEPFILE} "${dependencies}")
@@ -0,0 +1,47 @@
+// Global heap allocation counters.
+//
+// Linking `cpplearn::alloc_counter` replaces the global operator new/delete
+// family with versions that count calls and requested bytes before forwarding
+// to malloc/free.  The counters are process-wide relaxed atomics: cheap, but
+// not free, so only snippets that report allocations link it.
+#pragma once
+
+#include <cpplearn/bench.hpp>
+
+#include <cstdint>
+
+namespace cpplearn::bench {
+
+struct alloc_stats {
+    std::uint64_t allocations = 0;
+    std::uint64_t deallocations = 0;
+    std::uint64_t bytes = 0;  // requested bytes, not including allocator overhead
+};
+
+inline alloc_stats operator-(alloc_stats const& a, alloc_stats const& b) noexcept {
+    return {a.allocations - b.allocations, a.deallocations - b.deallocations, a.bytes - b.bytes};
+}
+
+// Counts since program start.
+alloc_stats alloc_snapshot() noexcept;
+
+// Reports `delta` as per-iteration `allocs` and `alloc_bytes` counters.
+inline void report_allocations(state& st, alloc_stats const& delta) {
+    st.set_counter("allocs", static_cast<double>(delta.allocations), counter_kind::per_iteration);
+    st.set_counter("alloc_bytes", static_cast<double>(delta.bytes), counter_kind::per_iteration);
+}
+
+// Snapshots on construction; `report` publishes everything allocated since.
+// Construct right before the timed loop and report right after it.
+class alloc_scope {
+public:
+    alloc_scope() noexcept : start_{alloc_snapshot()} {}
+
+    alloc_stats delta() const noexcept { return alloc_snapshot() - start_; }
+    void report(state& st) const { report_allocations(st, delta()); }
+
+private:
+    alloc_stats start_;
+};
+
+}  // namespace cpplearn::bench
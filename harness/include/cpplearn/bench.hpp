@@ -0,0 +1,239 @@
+// Microbenchmark harness shared by every snippet module.
+//
+// A snippet registers one or more benchmark functions with CPPLEARN_BENCHMARK
+// and links against `cpplearn::bench_main`, which provides `main`.  Each
+// benchmark body is written as
+//
+//     void bm_something(cpplearn::bench::state& st) {
+//         auto data = make_input(st.arg(0));   // untimed setup
+//         for (auto _ : st) {                  // timed region
+//             cpplearn::bench::do_not_optimize(work(data));
+//         }
+//         st.set_items_processed(st.iterations() * data.size());
+//     }
+//     CPPLEARN_BENCHMARK(bm_something)->range(1 << 10, 1 << 20);
+//
+// The runner calibrates an iteration count, runs a fixed number of warm-up
+// batches and then a fixed number of measured repetitions (see `options`).
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cpplearn::bench {
+
+// Keeps `value` alive as far as the optimizer is concerned.
+template <class T>
+inline void do_not_optimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <class T>
+inline void do_not_optimize(T& value) {
+    asm volatile("" : "+r,m"(value) : : "memory");
+}
+
+// Forces pending memory writes to be considered observable.
+inline void clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+
+enum class counter_kind {
+    absolute,       // reported as-is
+    per_iteration,  // divided by the iteration count
+    rate,           // divided by the measured seconds
+};
+
+struct counter {
+    double value = 0.0;
+    counter_kind kind = counter_kind::absolute;
+};
+
+// Per-batch state handed to a benchmark function.  The range-for loop over a
+// state is the timed region; anything before or after it is not measured.
+class state {
+public:
+    struct [[maybe_unused]] iteration_tag {};
+
+    class iterator {
+    public:
+        iterator() = default;
+        iterator(state* parent, std::uint64_t remaining) noexcept
+            : parent_{parent}, remaining_{remaining} {}
+
+        iteration_tag operator*() const noexcept { return {}; }
+
+        iterator& operator++() noexcept {
+            --remaining_;
+            return *this;
+        }
+
+        bool operator!=(iterator const&) const noexcept {
+            if (remaining_ != 0) [[likely]] {
+                return true;
+            }
+            parent_->finish_loop();
+            return false;
+        }
+
+    private:
+        state* parent_ = nullptr;
+        std::uint64_t remaining_ = 0;
+    };
+
+    state(std::uint64_t iterations, std::vector<std::int64_t> const& args, bool manual_time);
+
+    iterator begin();
+    iterator end() noexcept { return {}; }
+
+    std::uint64_t iterations() const noexcept { return iterations_; }
+    std::int64_t arg(std::size_t index = 0) const;
+    std::vector<std::int64_t> const& args() const noexcept { return *args_; }
+
+    // Temporarily exclude work inside the loop from the measurement.
+    void pause_timing();
+    void resume_timing();
+
+    // For benchmarks registered with `manual_time()`: adds the wall time of
+    // one iteration (or of any chunk of work) measured by the benchmark.
+    void set_iteration_time(double seconds);
+
+    // Replaces the range-for loop for multi-threaded benchmarks: runs
+    // `body(thread_index, iterations())` on `threads` threads, each pinned with
+    // worker_cpu().  The threads are started first and released together; the
+    // timed region runs from the release until the last one returns, so
+    // per-thread setup inside `body` is measured and should be kept small.
+    void run_threads(unsigned threads, std::function<void(unsigned, std::uint64_t)> const& body);
+
+    void set_items_processed(std::uint64_t items) noexcept { items_ = items; }
+    void set_bytes_processed(std::uint64_t bytes) noexcept { bytes_ = bytes; }
+    void set_counter(std::string const& name, double value,
+                     counter_kind kind = counter_kind::absolute);
+    void set_label(std::string label) { label_ = std::move(label); }
+
+    // Marks the run as failed; the timed loop is skipped if it has not started.
+    void error(std::string message);
+    // Marks the run as not applicable on this machine (missing CPU feature,
+    // kernel interface, ...).  Not a failure.
+    void skip(std::string reason);
+
+    // Used by the runner.
+    double elapsed_seconds() const noexcept { return elapsed_; }
+    std::uint64_t items_processed() const noexcept { return items_; }
+    std::uint64_t bytes_processed() const noexcept { return bytes_; }
+    std::map<std::string, counter> const& counters() const noexcept { return counters_; }
+    std::string const& label() const noexcept { return label_; }
+    std::string const& error_message() const noexcept { return error_; }
+    std::string const& skip_reason() const noexcept { return skip_; }
+    bool loop_finished() const noexcept { return finished_; }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    void finish_loop();
+
+    std::uint64_t iterations_;
+    std::vector<std::int64_t> const* args_;
+    bool manual_time_;
+    bool running_ = false;
+    bool finished_ = false;
+    clock::time_point start_{};
+    double elapsed_ = 0.0;
+    std::uint64_t items_ = 0;
+    std::uint64_t bytes_ = 0;
+    std::map<std::string, counter> counters_;
+    std::string label_;
+    std::string error_;
+    std::string skip_;
+};
+
+// A registered benchmark plus its argument sets.  Builder methods return
+// `this` so registrations chain with `->`.
+class benchmark {
+public:
+    using function = std::function<void(state&)>;
+
+    benchmark(std::string name, function fn);
+
+    benchmark* arg(std::int64_t value);
+    benchmark* args(std::vector<std::int64_t> values);
+    // lo, lo*multiplier, ... up to and including hi.
+    benchmark* range(std::int64_t lo, std::int64_t hi, std::int64_t multiplier = 8);
+    benchmark* dense_range(std::int64_t lo, std::int64_t hi, std::int64_t step = 1);
+    // Cartesian product of the given per-position value lists.
+    benchmark* args_product(std::vector<std::vector<std::int64_t>> const& lists);
+    benchmark* arg_names(std::vector<std::string> names);
+    // Overrides calibration with a fixed iteration count.
+    benchmark* iterations(std::uint64_t count);
+    benchmark* repetitions(unsigned count);
+    benchmark* manual_time();
+
+    std::string const& name() const noexcept { return name_; }
+    std::string display_name(std::vector<std::int64_t> const& args) const;
+    function const& fn() const noexcept { return fn_; }
+    std::vector<std::vector<std::int64_t>> const& arg_sets() const noexcept { return arg_sets_; }
+    std::uint64_t fixed_iterations() const noexcept { return iterations_; }
+    unsigned fixed_repetitions() const noexcept { return repetitions_; }
+    bool uses_manual_time() const noexcept { return manual_time_; }
+
+private:
+    std::string name_;
+    function fn_;
+    std::vector<std::vector<std::int64_t>> arg_sets_;
+    std::vector<std::string> arg_names_;
+    std::uint64_t iterations_ = 0;
+    unsigned repetitions_ = 0;
+    bool manual_time_ = false;
+};
+
+benchmark* register_benchmark(std::string name, benchmark::function fn);
+std::vector<std::unique_ptr<benchmark>>& registry();
+
+// Argument helpers.
+std::vector<std::int64_t> powers_of_two(std::int64_t lo, std::int64_t hi);
+// 1, 2, 4, ... up to the number of online CPUs, always ending with that count.
+std::vector<std::int64_t> thread_counts();
+
+// Platform helpers.
+unsigned hardware_threads() noexcept;
+bool pin_current_thread(int cpu) noexcept;
+// CPU for the n-th worker of a multi-threaded benchmark: the CPU given with
+// --cpu plus n, wrapping around.  -1 (do not pin) when --cpu was not given.
+int worker_cpu(unsigned worker) noexcept;
+
+struct cache_level {
+    unsigned level = 0;
+    std::size_t size = 0;  // bytes
+};
+// Data and unified caches of cpu0 from sysfs, smallest first; empty if unknown.
+std::vector<cache_level> const& data_caches();
+// "L1", "L2", ... for the smallest cache holding `bytes`, "DRAM" otherwise.
+std::string cache_fit(std::size_t bytes);
+
+// Entry point used by bench_main.
+int run(int argc, char** argv);
+
+}  // namespace cpplearn::bench
+
+#define CPPLEARN_BENCH_CONCAT_IMPL(a, b) a##b
+#define CPPLEARN_BENCH_CONCAT(a, b) CPPLEARN_BENCH_CONCAT_IMPL(a, b)
+
+// CPPLEARN_BENCHMARK(fn) or CPPLEARN_BENCHMARK(fn<T, U>): registers `fn`
+// under its spelled name.  The expression yields a `benchmark*` for chaining.
+#define CPPLEARN_BENCHMARK(...)                                                    \
+    [[maybe_unused]] static ::cpplearn::bench::benchmark* CPPLEARN_BENCH_CONCAT(  \
+        cpplearn_benchmark_, __LINE__) =                                           \
+        ::cpplearn::bench::register_benchmark(#__VA_ARGS__, __VA_ARGS__)
+
+// Registers a callable under an explicit name, e.g. for lambdas.
+#define CPPLEARN_BENCHMARK_NAMED(name, ...)                                        \
+    [[maybe_unused]] static ::cpplearn::bench::benchmark* CPPLEARN_BENCH_CONCAT(  \
+        cpplearn_benchmark_, __LINE__) =                                           \
+        ::cpplearn::bench::register_benchmark(name, __VA_ARGS__)
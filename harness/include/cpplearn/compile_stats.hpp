@@ -0,0 +1,53 @@
+// Build-time figures for the translation units behind a benchmark, as
+// measured by cpplearn_compile_stats() in CMake:
+//
+//   constexpr cpplearn::bench::compile_stat compile_stats[] = {
+//   #include "compile_stats.inc"
+//       {},
+//   };
+//   ...
+//   cpplearn::bench::report_compile_stats(st, compile_stats, "crc_bitwise");
+//
+// The generated file is empty when the build could not measure anything, so
+// the array always ends with the empty entry.
+#pragma once
+
+#include <cpplearn/bench.hpp>
+
+#include <span>
+#include <string_view>
+
+namespace cpplearn::bench {
+
+struct compile_stat {
+    char const* source = nullptr;  // file name without extension
+    double compile_ms = -1;        // user CPU time, best of three; negative if unmeasured
+    double code_bytes = 0;         // .text*, .rodata* and .data* sections
+    double unwind_bytes = 0;       // .eh_frame and .gcc_except_table
+};
+
+// Sets the code_bytes and unwind_bytes counters for `source`; nothing if it
+// was not measured.
+inline void report_code_size(state& st, std::span<compile_stat const> stats, std::string_view source) {
+    for (auto const& s : stats) {
+        if (s.source != nullptr && s.source == source) {
+            st.set_counter("code_bytes", s.code_bytes);
+            st.set_counter("unwind_bytes", s.unwind_bytes);
+        }
+    }
+}
+
+// As report_code_size, plus the compile_ms counter when the compiler
+// reported its time.
+inline void report_compile_stats(state& st, std::span<compile_stat const> stats, std::string_view source) {
+    for (auto const& s : stats) {
+        if (s.source != nullptr && s.source == source) {
+            if (s.compile_ms >= 0) {
+                st.set_counter("compile_ms", s.compile_ms);
+            }
+        }
+    }
+    report_code_size(st, stats, source);
+}
+
+}  // namespace cpplearn::bench
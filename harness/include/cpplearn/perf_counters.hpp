@@ -0,0 +1,56 @@
+// Hardware performance counters through perf_event_open(2).
+//
+// Counts user-space cycles, instructions, cache references/misses and L1D
+// read misses for the calling thread as one group, so the values are
+// scheduled together and scaled consistently if the kernel multiplexes them.
+// When the kernel or the virtual machine does not expose a PMU (or
+// perf_event_paranoid forbids it) `available()` is false and `report` only
+// sets a label, so snippets can use the counters unconditionally.
+#pragma once
+
+#include <cpplearn/bench.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace cpplearn::bench {
+
+class perf_counters {
+public:
+    enum event : unsigned {
+        cycles,
+        instructions,
+        cache_references,
+        cache_misses,
+        l1d_read_misses,
+        event_count,
+    };
+
+    perf_counters();
+    ~perf_counters();
+
+    perf_counters(perf_counters const&) = delete;
+    perf_counters& operator=(perf_counters const&) = delete;
+
+    bool available() const noexcept { return fds_[cycles] >= 0; }
+    std::string const& error() const noexcept { return error_; }
+
+    void start() noexcept;
+    void stop() noexcept;
+
+    // Scaled count for `e`, or a negative value if that event is unsupported.
+    double value(event e) const noexcept { return values_[e]; }
+
+    // Adds per-iteration cycles, instructions, cache misses and L1D misses plus
+    // the IPC as counters on `st`; notes it in the label if counters are
+    // unavailable.
+    void report(state& st) const;
+
+private:
+    int fds_[event_count];
+    std::uint64_t ids_[event_count] = {};
+    double values_[event_count] = {};
+    std::string error_;
+};
+
+}  // namespace cpplearn::bench
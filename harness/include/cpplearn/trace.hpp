@@ -0,0 +1,297 @@
+// Header-only hot-path instrumentation: scoped timers, per-thread event
+// buffers and Chrome trace export.
+//
+//   void parse(...) {
+//       CPPLEARN_TRACE_SCOPE("parse");   // nothing at all unless CPPLEARN_TRACE
+//       ...
+//   }
+//   cpplearn::trace::write_chrome_trace("out.json");  // or bench_x --trace=out.json
+//
+// A scope reads the clock on entry and exit and appends one complete event
+// (name, begin, end) to a buffer owned by the calling thread: no lock, no
+// atomic read-modify-write, no allocation after the thread's first event.
+// Each buffer is a ring of `buffer_capacity` events, so a long run keeps the
+// most recent ones, like a flight recorder.
+//
+// Two clocks: `tsc_clock` reads the time-stamp counter (rdtsc, a few ns, not
+// serializing, so it can be reordered with neighbouring instructions) and
+// `monotonic_clock` calls clock_gettime(CLOCK_MONOTONIC) (vDSO, some tens of
+// ns).  Events from both land on one timeline: TSC ticks are converted with a
+// rate calibrated against CLOCK_MONOTONIC on first use.  Off x86 the TSC
+// clock falls back to CLOCK_MONOTONIC.
+//
+// The CPPLEARN_TRACE macro (the CMake option of the same name) only decides
+// what CPPLEARN_TRACE_SCOPE expands to; the classes are always available, so
+// translation units built with and without it can share a program.
+#pragma once
+
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef CPPLEARN_TRACE
+#define CPPLEARN_TRACE 0
+#endif
+
+namespace cpplearn::trace {
+
+enum class clock_kind : std::uint8_t { tsc, monotonic };
+
+struct monotonic_clock {
+    static constexpr clock_kind kind = clock_kind::monotonic;
+
+    static std::uint64_t now() noexcept {
+        timespec ts;
+        ::clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<std::uint64_t>(ts.tv_sec) * 1'000'000'000u + static_cast<std::uint64_t>(ts.tv_nsec);
+    }
+};
+
+struct tsc_clock {
+    static constexpr clock_kind kind = clock_kind::tsc;
+
+    static std::uint64_t now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return monotonic_clock::now();
+#endif
+    }
+};
+
+// Maps TSC ticks onto CLOCK_MONOTONIC nanoseconds.  Measured once, over
+// about 10 ms, the first time a trace is exported.
+struct tsc_calibration {
+    std::uint64_t tsc0;
+    std::uint64_t ns0;
+    double ns_per_tick;
+
+    static tsc_calibration const& get() {
+        static tsc_calibration const c = [] {
+#if defined(__x86_64__) || defined(__i386__)
+            std::uint64_t const tsc0 = tsc_clock::now();
+            std::uint64_t const ns0 = monotonic_clock::now();
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+            std::uint64_t const tsc1 = tsc_clock::now();
+            std::uint64_t const ns1 = monotonic_clock::now();
+            return tsc_calibration{tsc0, ns0, static_cast<double>(ns1 - ns0) / static_cast<double>(tsc1 - tsc0)};
+#else
+            return tsc_calibration{0, 0, 1.0};
+#endif
+        }();
+        return c;
+    }
+
+    double to_ns(std::uint64_t ticks) const noexcept {
+        return static_cast<double>(ns0) + static_cast<double>(static_cast<std::int64_t>(ticks - tsc0)) * ns_per_tick;
+    }
+};
+
+// `name` must outlive the export: string literals are the intended use.
+struct event {
+    char const* name;
+    std::uint64_t begin;
+    std::uint64_t end;
+    clock_kind clock;
+};
+
+inline constexpr std::size_t buffer_capacity = std::size_t{1} << 16;  // events per thread, a power of two
+
+// Written only by its thread.  `head_` counts every event ever pushed; the
+// release store publishes the event to an exporter reading concurrently, but
+// an exporter racing a writer that has wrapped around may still see a slot
+// being overwritten, so export after the traced work has finished.
+class thread_buffer {
+public:
+    explicit thread_buffer(std::uint32_t tid) : tid_{tid}, events_{new event[buffer_capacity]} {}
+
+    void push(event const& e) noexcept {
+        std::uint64_t const head = head_.load(std::memory_order_relaxed);
+        events_[head & (buffer_capacity - 1)] = e;
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    // Calls f(event const&) for the retained events, oldest first.
+    template <class F>
+    void for_each(F&& f) const {
+        std::uint64_t const head = head_.load(std::memory_order_acquire);
+        std::uint64_t const first = head > buffer_capacity ? head - buffer_capacity : 0;
+        for (std::uint64_t i = first; i < head; ++i) {
+            f(events_[i & (buffer_capacity - 1)]);
+        }
+    }
+
+    std::uint64_t recorded() const noexcept { return head_.load(std::memory_order_acquire); }
+    std::uint32_t tid() const noexcept { return tid_; }
+    void clear() noexcept { head_.store(0, std::memory_order_release); }
+
+private:
+    std::uint32_t tid_;
+    std::atomic<std::uint64_t> head_{0};
+    std::unique_ptr<event[]> events_;
+};
+
+// Owns every thread's buffer, so events survive the threads that wrote them.
+// When a thread exits its buffer is retired and handed, events and all, to
+// the next thread that starts recording: memory stays bounded by the largest
+// number of threads recording at once, not by how many were ever created.
+// The mutex is taken when a thread starts and stops recording and by
+// exporters.
+class registry {
+public:
+    static registry& instance() {
+        static registry r;
+        return r;
+    }
+
+    thread_buffer* acquire() {
+        std::lock_guard lock{mutex_};
+        for (auto& [buffer, retired] : buffers_) {
+            if (retired) {
+                retired = false;
+                return buffer.get();
+            }
+        }
+        auto const tid = static_cast<std::uint32_t>(buffers_.size());
+        return buffers_.emplace_back(std::make_unique<thread_buffer>(tid), false).first.get();
+    }
+
+    void release(thread_buffer* buffer) {
+        std::lock_guard lock{mutex_};
+        for (auto& [b, retired] : buffers_) {
+            retired = retired || b.get() == buffer;
+        }
+    }
+
+    template <class F>
+    void for_each_buffer(F&& f) const {
+        std::lock_guard lock{mutex_};
+        for (auto const& [buffer, retired] : buffers_) {
+            f(*buffer);
+        }
+    }
+
+    // Only while no thread is recording.
+    void clear() {
+        std::lock_guard lock{mutex_};
+        for (auto const& [buffer, retired] : buffers_) {
+            buffer->clear();
+        }
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::pair<std::unique_ptr<thread_buffer>, bool>> buffers_;  // buffer, retired
+};
+
+inline thread_buffer& local_buffer() {
+    struct lease {
+        thread_buffer* const buffer = registry::instance().acquire();
+        ~lease() { registry::instance().release(buffer); }
+    };
+    thread_local lease const l;
+    return *l.buffer;
+}
+
+inline void record(char const* name, std::uint64_t begin, std::uint64_t end, clock_kind clock) noexcept {
+    local_buffer().push({name, begin, end, clock});
+}
+
+// Records [construction, destruction) as one event named `name`.
+template <class Clock = tsc_clock>
+class scope {
+public:
+    explicit scope(char const* name) noexcept : name_{name}, begin_{Clock::now()} {}
+    ~scope() { record(name_, begin_, Clock::now(), Clock::kind); }
+
+    scope(scope const&) = delete;
+    scope& operator=(scope const&) = delete;
+
+private:
+    char const* name_;
+    std::uint64_t begin_;
+};
+
+// Chrome trace event format ("X" complete events, microseconds), loadable in
+// chrome://tracing and Perfetto.  Writes every retained event of every thread.
+inline void write_chrome_trace(std::ostream& out) {
+    auto const& tsc = tsc_calibration::get();
+    auto const to_ns = [&tsc](std::uint64_t t, clock_kind clock) {
+        return clock == clock_kind::tsc ? tsc.to_ns(t) : static_cast<double>(t);
+    };
+
+    // Each event is formatted into `line` with to_chars and written in one
+    // call; going through operator<< for the numbers is several times slower.
+    std::string line;
+    auto const append_number = [&line](auto value, auto... format) {
+        char buf[32];
+        auto const [end, ec] = std::to_chars(buf, buf + sizeof buf, value, format...);
+        line.append(buf, ec == std::errc{} ? end : buf);
+    };
+    auto const append_us = [&](double ns) { append_number(ns / 1000.0, std::chars_format::fixed, 3); };
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    registry::instance().for_each_buffer([&](thread_buffer const& buffer) {
+        line = first ? "\n" : ",\n";
+        line += R"({"name":"thread_name","ph":"M","pid":1,"tid":)";
+        append_number(buffer.tid());
+        line += R"(,"args":{"name":"thread )";
+        append_number(buffer.tid());
+        line += "\"}}";
+        out << line;
+        first = false;
+        buffer.for_each([&](event const& e) {
+            line = ",\n{\"name\":\"";
+            for (char const* p = e.name; *p != '\0'; ++p) {
+                if (*p == '"' || *p == '\\') {
+                    line += '\\';
+                }
+                line += *p;
+            }
+            line += R"(","ph":"X","pid":1,"tid":)";
+            append_number(buffer.tid());
+            double const begin = to_ns(e.begin, e.clock);
+            line += ",\"ts\":";
+            append_us(begin);
+            line += ",\"dur\":";
+            append_us(to_ns(e.end, e.clock) - begin);
+            line += '}';
+            out.write(line.data(), static_cast<std::streamsize>(line.size()));
+        });
+    });
+    out << "\n]}\n";
+}
+
+inline bool write_chrome_trace(std::string const& path) {
+    std::ofstream out{path};
+    write_chrome_trace(out);
+    return static_cast<bool>(out);
+}
+
+}  // namespace cpplearn::trace
+
+#define CPPLEARN_TRACE_CONCAT_(a, b) a##b
+#define CPPLEARN_TRACE_CONCAT(a, b) CPPLEARN_TRACE_CONCAT_(a, b)
+
+#if CPPLEARN_TRACE
+#define CPPLEARN_TRACE_SCOPE(name) \
+    ::cpplearn::trace::scope<> const CPPLEARN_TRACE_CONCAT(cpplearn_trace_scope_, __LINE__) { name }
+#else
+#define CPPLEARN_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
@@ -0,0 +1,237 @@
+#include "cpplearn/bench.hpp"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace cpplearn::bench {
+
+state::state(std::uint64_t iterations, std::vector<std::int64_t> const& args, bool manual_time)
+    : iterations_{iterations}, args_{&args}, manual_time_{manual_time} {}
+
+state::iterator state::begin() {
+    if (!error_.empty() || !skip_.empty()) {
+        finished_ = true;
+        return {};
+    }
+    if (!manual_time_) {
+        resume_timing();
+    }
+    return {this, iterations_};
+}
+
+void state::finish_loop() {
+    if (running_) {
+        pause_timing();
+    }
+    finished_ = true;
+}
+
+std::int64_t state::arg(std::size_t index) const {
+    if (index >= args_->size()) {
+        throw std::out_of_range{"benchmark argument index out of range"};
+    }
+    return (*args_)[index];
+}
+
+void state::pause_timing() {
+    if (!running_) {
+        return;
+    }
+    elapsed_ += std::chrono::duration<double>(clock::now() - start_).count();
+    running_ = false;
+}
+
+void state::resume_timing() {
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    start_ = clock::now();
+}
+
+void state::set_iteration_time(double seconds) {
+    elapsed_ += seconds;
+}
+
+void state::run_threads(unsigned threads,
+                        std::function<void(unsigned, std::uint64_t)> const& body) {
+    if (!error_.empty() || !skip_.empty()) {
+        finished_ = true;
+        return;
+    }
+
+    std::atomic<unsigned> ready{0};
+    std::atomic<bool> go{false};
+    std::exception_ptr failure;
+    std::mutex failure_mutex;
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            pin_current_thread(worker_cpu(t));
+            ready.fetch_add(1, std::memory_order_release);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            try {
+                body(t, iterations_);
+            } catch (...) {
+                std::lock_guard lock{failure_mutex};
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+        });
+    }
+    while (ready.load(std::memory_order_acquire) != threads) {
+        std::this_thread::yield();
+    }
+
+    if (!manual_time_) {
+        resume_timing();
+    }
+    go.store(true, std::memory_order_release);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    finish_loop();
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+void state::set_counter(std::string const& name, double value, counter_kind kind) {
+    counters_[name] = counter{value, kind};
+}
+
+void state::error(std::string message) {
+    if (running_) {
+        pause_timing();
+    }
+    error_ = std::move(message);
+}
+
+void state::skip(std::string reason) {
+    if (running_) {
+        pause_timing();
+    }
+    skip_ = std::move(reason);
+}
+
+benchmark::benchmark(std::string name, function fn) : name_{std::move(name)}, fn_{std::move(fn)} {}
+
+benchmark* benchmark::arg(std::int64_t value) {
+    arg_sets_.push_back({value});
+    return this;
+}
+
+benchmark* benchmark::args(std::vector<std::int64_t> values) {
+    arg_sets_.push_back(std::move(values));
+    return this;
+}
+
+benchmark* benchmark::range(std::int64_t lo, std::int64_t hi, std::int64_t multiplier) {
+    if (multiplier < 2) {
+        throw std::invalid_argument{"range multiplier must be at least 2"};
+    }
+    for (std::int64_t value = lo; value < hi; value *= multiplier) {
+        arg(value);
+    }
+    return arg(hi);
+}
+
+benchmark* benchmark::dense_range(std::int64_t lo, std::int64_t hi, std::int64_t step) {
+    for (std::int64_t value = lo; value <= hi; value += step) {
+        arg(value);
+    }
+    return this;
+}
+
+benchmark* benchmark::args_product(std::vector<std::vector<std::int64_t>> const& lists) {
+    std::vector<std::vector<std::int64_t>> product{{}};
+    for (auto const& list : lists) {
+        std::vector<std::vector<std::int64_t>> next;
+        next.reserve(product.size() * list.size());
+        for (auto const& prefix : product) {
+            for (auto value : list) {
+                auto combined = prefix;
+                combined.push_back(value);
+                next.push_back(std::move(combined));
+            }
+        }
+        product = std::move(next);
+    }
+    for (auto& set : product) {
+        arg_sets_.push_back(std::move(set));
+    }
+    return this;
+}
+
+benchmark* benchmark::arg_names(std::vector<std::string> names) {
+    arg_names_ = std::move(names);
+    return this;
+}
+
+benchmark* benchmark::iterations(std::uint64_t count) {
+    iterations_ = count;
+    return this;
+}
+
+benchmark* benchmark::repetitions(unsigned count) {
+    repetitions_ = count;
+    return this;
+}
+
+benchmark* benchmark::manual_time() {
+    manual_time_ = true;
+    return this;
+}
+
+std::string benchmark::display_name(std::vector<std::int64_t> const& args) const {
+    std::string result = name_;
+    for (std::size_t i = 0; i < args.size(); ++i) {
+        result += '/';
+        if (i < arg_names_.size() && !arg_names_[i].empty()) {
+            result += arg_names_[i];
+            result += ':';
+        }
+        result += std::to_string(args[i]);
+    }
+    return result;
+}
+
+std::vector<std::unique_ptr<benchmark>>& registry() {
+    static std::vector<std::unique_ptr<benchmark>> benchmarks;
+    return benchmarks;
+}
+
+benchmark* register_benchmark(std::string name, benchmark::function fn) {
+    auto& benchmarks = registry();
+    benchmarks.push_back(std::make_unique<benchmark>(std::move(name), std::move(fn)));
+    return benchmarks.back().get();
+}
+
+std::vector<std::int64_t> powers_of_two(std::int64_t lo, std::int64_t hi) {
+    std::vector<std::int64_t> values;
+    for (std::int64_t value = lo; value <= hi; value *= 2) {
+        values.push_back(value);
+    }
+    return values;
+}
+
+std::vector<std::int64_t> thread_counts() {
+    auto const max = static_cast<std::int64_t>(hardware_threads());
+    std::vector<std::int64_t> counts;
+    for (std::int64_t n = 1; n < max; n *= 2) {
+        counts.push_back(n);
+    }
+    counts.push_back(max);
+    return counts;
+}
+
+}  // namespace cpplearn::bench
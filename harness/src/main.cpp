@@ -0,0 +1,5 @@
+#include "cpplearn/bench.hpp"
+
+int main(int argc, char** argv) {
+    return cpplearn::bench::run(argc, argv);
+}
@@ -0,0 +1,130 @@
+#include "cpplearn/perf_counters.hpp"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace cpplearn::bench {
+
+namespace {
+
+struct event_spec {
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+constexpr event_spec specs[perf_counters::event_count] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+};
+
+int open_event(event_spec const& spec, int group_fd) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = group_fd < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+}  // namespace
+
+perf_counters::perf_counters() {
+    for (auto& fd : fds_) {
+        fd = -1;
+    }
+    for (auto& v : values_) {
+        v = -1.0;
+    }
+
+    fds_[cycles] = open_event(specs[cycles], -1);
+    if (fds_[cycles] < 0) {
+        error_ = std::string{"perf_event_open: "} + std::strerror(errno);
+        return;
+    }
+    for (unsigned e = cycles + 1; e < event_count; ++e) {
+        // Individual events may be missing (e.g. no L1D event in a VM).
+        fds_[e] = open_event(specs[e], fds_[cycles]);
+    }
+    for (unsigned e = 0; e < event_count; ++e) {
+        if (fds_[e] >= 0) {
+            ::ioctl(fds_[e], PERF_EVENT_IOC_ID, &ids_[e]);
+        }
+    }
+}
+
+perf_counters::~perf_counters() {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+void perf_counters::start() noexcept {
+    if (!available()) {
+        return;
+    }
+    ::ioctl(fds_[cycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(fds_[cycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void perf_counters::stop() noexcept {
+    if (!available()) {
+        return;
+    }
+    ::ioctl(fds_[cycles], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // nr, time_enabled, time_running, then {value, id} per event.
+    std::uint64_t buffer[3 + 2 * event_count] = {};
+    if (::read(fds_[cycles], buffer, sizeof(buffer)) <= 0) {
+        return;
+    }
+    std::uint64_t const nr = buffer[0];
+    double const scale = buffer[2] ? static_cast<double>(buffer[1]) / static_cast<double>(buffer[2]) : 1.0;
+    for (std::uint64_t i = 0; i < nr && i < event_count; ++i) {
+        std::uint64_t const value = buffer[3 + 2 * i];
+        std::uint64_t const id = buffer[4 + 2 * i];
+        for (unsigned e = 0; e < event_count; ++e) {
+            if (fds_[e] >= 0 && ids_[e] == id) {
+                values_[e] = static_cast<double>(value) * scale;
+            }
+        }
+    }
+}
+
+void perf_counters::report(state& st) const {
+    if (!available()) {
+        std::string label = st.label();
+        if (!label.empty()) {
+            label += ", ";
+        }
+        label += "no perf counters";
+        st.set_label(std::move(label));
+        return;
+    }
+    static char const* const names[event_count] = {"cycles", "instructions", "cache_refs", "cache_misses",
+                                                    "l1d_misses"};
+    for (unsigned e = 0; e < event_count; ++e) {
+        if (values_[e] >= 0.0) {
+            st.set_counter(names[e], values_[e], counter_kind::per_iteration);
+        }
+    }
+    if (values_[cycles] > 0.0 && values_[instructions] >= 0.0) {
+        st.set_counter("ipc", values_[instructions] / values_[cycles]);
+    }
+}
+
+}  // namespace cpplearn::bench
@@ -0,0 +1,131 @@
+#include "platform.hpp"
+
+#include "cpplearn/bench.hpp"
+
+#include <sched.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+
+namespace cpplearn::bench {
+
+namespace {
+
+int base_cpu = -1;
+
+std::string read_first_line(char const* path) {
+    std::ifstream in{path};
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+}  // namespace
+
+unsigned hardware_threads() noexcept {
+    long const online = ::sysconf(_SC_NPROCESSORS_ONLN);
+    return online > 0 ? static_cast<unsigned>(online) : 1u;
+}
+
+bool pin_current_thread(int cpu) noexcept {
+    if (cpu < 0) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<unsigned>(cpu), &set);
+    return ::sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+int worker_cpu(unsigned worker) noexcept {
+    if (base_cpu < 0) {
+        return -1;
+    }
+    return static_cast<int>((static_cast<unsigned>(base_cpu) + worker) % hardware_threads());
+}
+
+std::vector<cache_level> const& data_caches() {
+    static std::vector<cache_level> const caches = [] {
+        std::vector<cache_level> found;
+        for (unsigned index = 0;; ++index) {
+            std::string const dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+            std::string const type = read_first_line((dir + "type").c_str());
+            if (type.empty()) {
+                break;
+            }
+            if (type == "Instruction") {
+                continue;
+            }
+            std::string const size = read_first_line((dir + "size").c_str());
+            std::size_t value = 0;
+            std::size_t pos = 0;
+            while (pos < size.size() && size[pos] >= '0' && size[pos] <= '9') {
+                value = value * 10 + static_cast<std::size_t>(size[pos++] - '0');
+            }
+            if (pos < size.size() && size[pos] == 'K') {
+                value *= 1024;
+            } else if (pos < size.size() && size[pos] == 'M') {
+                value *= 1024 * 1024;
+            }
+            std::string const level_text = read_first_line((dir + "level").c_str());
+            auto const level = level_text.empty() ? 0u : static_cast<unsigned>(std::stoul(level_text));
+            found.push_back({level, value});
+        }
+        std::sort(found.begin(), found.end(),
+                  [](cache_level const& a, cache_level const& b) { return a.level < b.level; });
+        return found;
+    }();
+    return caches;
+}
+
+std::string cache_fit(std::size_t bytes) {
+    for (auto const& cache : data_caches()) {
+        if (bytes <= cache.size) {
+            std::string label = "L";
+            label += std::to_string(cache.level);
+            return label;
+        }
+    }
+    return "DRAM";
+}
+
+void set_base_cpu(int cpu) noexcept {
+    base_cpu = cpu;
+}
+
+run_context collect_context(std::string const& executable) {
+    run_context ctx;
+    ctx.executable = executable;
+
+    char host[256] = {};
+    if (::gethostname(host, sizeof(host) - 1) == 0) {
+        ctx.host = host;
+    }
+
+    std::ifstream cpuinfo{"/proc/cpuinfo"};
+    for (std::string line; std::getline(cpuinfo, line);) {
+        if (line.rfind("model name", 0) == 0) {
+            if (auto colon = line.find(':'); colon != std::string::npos) {
+                ctx.cpu_model = line.substr(colon + 2);
+            }
+            break;
+        }
+    }
+    ctx.cpus = hardware_threads();
+    ctx.governor = read_first_line("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor");
+
+    ctx.compiler = __VERSION__;
+#ifdef CPPLEARN_BUILD_TYPE
+    ctx.build_type = CPPLEARN_BUILD_TYPE;
+#endif
+
+    std::time_t const now = std::time(nullptr);
+    char date[32] = {};
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    ctx.date = date;
+    return ctx;
+}
+
+}  // namespace cpplearn::bench
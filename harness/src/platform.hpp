@@ -0,0 +1,22 @@
+// Machine description and thread placement used by the runner.
+#pragma once
+
+#include <string>
+
+namespace cpplearn::bench {
+
+struct run_context {
+    std::string executable;
+    std::string host;
+    std::string cpu_model;
+    unsigned cpus = 0;
+    std::string governor;
+    std::string compiler;
+    std::string build_type;
+    std::string date;
+};
+
+run_context collect_context(std::string const& executable);
+void set_base_cpu(int cpu) noexcept;
+
+}  // namespace cpplearn::bench
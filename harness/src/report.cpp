@@ -0,0 +1,225 @@
+#include "report.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+#include <set>
+
+namespace cpplearn::bench {
+
+namespace {
+
+std::string json_escape(std::string const& text) {
+    std::string escaped;
+    escaped.reserve(text.size() + 2);
+    for (char c : text) {
+        switch (c) {
+        case '"': escaped += "\\\""; break;
+        case '\\': escaped += "\\\\"; break;
+        case '\n': escaped += "\\n"; break;
+        case '\t': escaped += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                escaped += buf;
+            } else {
+                escaped += c;
+            }
+        }
+    }
+    return escaped;
+}
+
+std::string csv_escape(std::string const& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) {
+        return text;
+    }
+    std::string escaped = "\"";
+    for (char c : text) {
+        if (c == '"') {
+            escaped += '"';
+        }
+        escaped += c;
+    }
+    return escaped + '"';
+}
+
+std::string format_number(double value) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.6g", value);
+    return buf;
+}
+
+// JSON has no NaN or infinity; a counter divided by a zero time or count
+// is written as null rather than as an invalid document.
+std::string json_number(double value) {
+    return std::isfinite(value) ? format_number(value) : "null";
+}
+
+std::string human_rate(double per_second, char const* unit) {
+    static char const* const prefixes[] = {"", "k", "M", "G", "T"};
+    std::size_t i = 0;
+    while (per_second >= 1000.0 && i + 1 < std::size(prefixes)) {
+        per_second /= 1000.0;
+        ++i;
+    }
+    char buf[48];
+    std::snprintf(buf, sizeof(buf), "%.3g %s%s/s", per_second, prefixes[i], unit);
+    return buf;
+}
+
+}  // namespace
+
+void write_text(std::ostream& out, run_context const& ctx, options const& opts,
+                std::vector<result> const& results) {
+    out << ctx.executable << " on " << ctx.cpu_model << " (" << ctx.cpus << " cpus";
+    if (!ctx.governor.empty()) {
+        out << ", governor " << ctx.governor;
+    }
+    out << ")\n";
+    if (!ctx.governor.empty() && ctx.governor != "performance") {
+        out << "warning: CPU frequency scaling is enabled, numbers will be noisy\n";
+    }
+    out << "warmup " << opts.warmup << ", repetitions " << opts.repetitions;
+    if (opts.cpu >= 0) {
+        out << ", pinned to cpu " << opts.cpu;
+    }
+    out << "\n\n";
+
+    std::size_t width = 40;
+    for (auto const& r : results) {
+        width = std::max(width, r.name.size() + 2);
+    }
+    char line[512];
+    std::snprintf(line, sizeof(line), "%-*s %14s %12s %8s\n", static_cast<int>(width), "benchmark",
+                  "ns/op", "iterations", "cv%");
+    out << line << std::string(width + 37, '-') << '\n';
+
+    for (auto const& r : results) {
+        if (!r.error.empty()) {
+            std::snprintf(line, sizeof(line), "%-*s ERROR: ", static_cast<int>(width), r.name.c_str());
+            out << line << r.error << '\n';
+            continue;
+        }
+        if (!r.skipped.empty()) {
+            std::snprintf(line, sizeof(line), "%-*s skipped: ", static_cast<int>(width), r.name.c_str());
+            out << line << r.skipped << '\n';
+            continue;
+        }
+        double const cv = r.ns_mean > 0.0 ? 100.0 * r.ns_stddev / r.ns_mean : 0.0;
+        std::snprintf(line, sizeof(line), "%-*s %14.2f %12llu %8.2f", static_cast<int>(width),
+                      r.name.c_str(), r.ns_median, static_cast<unsigned long long>(r.iterations), cv);
+        out << line;
+        if (r.items_per_second > 0.0) {
+            out << "  " << human_rate(r.items_per_second, "items");
+        }
+        if (r.bytes_per_second > 0.0) {
+            out << "  " << human_rate(r.bytes_per_second, "B");
+        }
+        for (auto const& [name, value] : r.counters) {
+            out << "  " << name << '=' << format_number(value);
+        }
+        if (!r.label.empty()) {
+            out << "  " << r.label;
+        }
+        out << '\n';
+    }
+}
+
+void write_json(std::ostream& out, run_context const& ctx, options const& opts,
+                std::vector<result> const& results) {
+    out << "{\n  \"context\": {\n";
+    out << "    \"executable\": \"" << json_escape(ctx.executable) << "\",\n";
+    out << "    \"host\": \"" << json_escape(ctx.host) << "\",\n";
+    out << "    \"date\": \"" << json_escape(ctx.date) << "\",\n";
+    out << "    \"cpu_model\": \"" << json_escape(ctx.cpu_model) << "\",\n";
+    out << "    \"cpus\": " << ctx.cpus << ",\n";
+    out << "    \"governor\": \"" << json_escape(ctx.governor) << "\",\n";
+    out << "    \"compiler\": \"" << json_escape(ctx.compiler) << "\",\n";
+    out << "    \"build_type\": \"" << json_escape(ctx.build_type) << "\",\n";
+    out << "    \"warmup\": " << opts.warmup << ",\n";
+    out << "    \"repetitions\": " << opts.repetitions << ",\n";
+    out << "    \"min_time\": " << json_number(opts.min_time) << ",\n";
+    out << "    \"pinned_cpu\": " << opts.cpu << "\n";
+    out << "  },\n  \"benchmarks\": [";
+
+    char const* separator = "\n";
+    for (auto const& r : results) {
+        out << separator << "    {\n";
+        separator = ",\n";
+        out << "      \"name\": \"" << json_escape(r.name) << "\",\n";
+        out << "      \"args\": [";
+        for (std::size_t i = 0; i < r.args.size(); ++i) {
+            out << (i ? ", " : "") << r.args[i];
+        }
+        out << "],\n";
+        if (!r.error.empty()) {
+            out << "      \"error\": \"" << json_escape(r.error) << "\"\n    }";
+            continue;
+        }
+        if (!r.skipped.empty()) {
+            out << "      \"skipped\": \"" << json_escape(r.skipped) << "\"\n    }";
+            continue;
+        }
+        out << "      \"iterations\": " << r.iterations << ",\n";
+        out << "      \"repetitions\": " << r.repetitions << ",\n";
+        out << "      \"ns_per_op\": {\"min\": " << json_number(r.ns_min)
+            << ", \"median\": " << json_number(r.ns_median)
+            << ", \"mean\": " << json_number(r.ns_mean)
+            << ", \"max\": " << json_number(r.ns_max)
+            << ", \"stddev\": " << json_number(r.ns_stddev) << "},\n";
+        out << "      \"items_per_second\": " << json_number(r.items_per_second) << ",\n";
+        out << "      \"bytes_per_second\": " << json_number(r.bytes_per_second) << ",\n";
+        out << "      \"label\": \"" << json_escape(r.label) << "\",\n";
+        out << "      \"counters\": {";
+        char const* counter_separator = "";
+        for (auto const& [name, value] : r.counters) {
+            out << counter_separator << '"' << json_escape(name) << "\": " << json_number(value);
+            counter_separator = ", ";
+        }
+        out << "}\n    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void write_csv(std::ostream& out, std::vector<result> const& results) {
+    std::set<std::string> counter_names;
+    for (auto const& r : results) {
+        for (auto const& [name, value] : r.counters) {
+            counter_names.insert(name);
+        }
+    }
+
+    out << "name,iterations,repetitions,ns_min,ns_median,ns_mean,ns_max,ns_stddev,"
+           "items_per_second,bytes_per_second";
+    for (auto const& name : counter_names) {
+        out << ',' << csv_escape(name);
+    }
+    out << ",label,status\n";
+
+    for (auto const& r : results) {
+        out << csv_escape(r.name) << ',' << r.iterations << ',' << r.repetitions << ','
+            << format_number(r.ns_min) << ',' << format_number(r.ns_median) << ','
+            << format_number(r.ns_mean) << ',' << format_number(r.ns_max) << ','
+            << format_number(r.ns_stddev) << ',' << format_number(r.items_per_second) << ','
+            << format_number(r.bytes_per_second);
+        for (auto const& name : counter_names) {
+            out << ',';
+            if (auto it = r.counters.find(name); it != r.counters.end()) {
+                out << format_number(it->second);
+            }
+        }
+        out << ',' << csv_escape(r.label) << ',';
+        if (!r.error.empty()) {
+            out << csv_escape("error: " + r.error);
+        } else if (!r.skipped.empty()) {
+            out << csv_escape("skipped: " + r.skipped);
+        } else {
+            out << "ok";
+        }
+        out << '\n';
+    }
+}
+
+}  // namespace cpplearn::bench
@@ -0,0 +1,53 @@
+// Result records and the text/JSON/CSV reporters.
+#pragma once
+
+#include "platform.hpp"
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cpplearn::bench {
+
+enum class output_format { text, json, csv };
+
+struct options {
+    std::uint64_t iterations = 0;  // 0: calibrate per benchmark
+    unsigned warmup = 1;           // discarded batches after calibration
+    unsigned repetitions = 5;      // measured batches
+    double min_time = 0.05;        // calibration target per batch, seconds
+    int cpu = -1;                  // pin the runner thread, -1: no pinning
+    output_format format = output_format::text;
+    std::string out;
+    std::string filter;
+    std::string trace;  // Chrome trace output path, empty: none
+    bool list = false;
+};
+
+struct result {
+    std::string name;
+    std::vector<std::int64_t> args;
+    std::uint64_t iterations = 0;
+    unsigned repetitions = 0;
+    double ns_min = 0.0;
+    double ns_median = 0.0;
+    double ns_mean = 0.0;
+    double ns_max = 0.0;
+    double ns_stddev = 0.0;
+    double items_per_second = 0.0;
+    double bytes_per_second = 0.0;
+    std::map<std::string, double> counters;
+    std::string label;
+    std::string error;
+    std::string skipped;
+};
+
+void write_text(std::ostream& out, run_context const& ctx, options const& opts,
+                std::vector<result> const& results);
+void write_json(std::ostream& out, run_context const& ctx, options const& opts,
+                std::vector<result> const& results);
+void write_csv(std::ostream& out, std::vector<result> const& results);
+
+}  // namespace cpplearn::bench
@@ -0,0 +1,329 @@
+#include "cpplearn/bench.hpp"
+#include "cpplearn/trace.hpp"
+
+#include "platform.hpp"
+#include "report.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <regex>
+#include <string_view>
+
+namespace cpplearn::bench {
+
+namespace {
+
+constexpr std::uint64_t max_iterations = 1'000'000'000;
+
+void print_usage(char const* argv0) {
+    std::cout
+        << "usage: " << argv0 << " [options]\n"
+        << "  --filter=REGEX       run only benchmarks whose name matches REGEX\n"
+        << "  --list               list benchmark names and exit\n"
+        << "  --iterations=N       fixed iteration count (default: calibrate)\n"
+        << "  --min-time=SECONDS   calibration target per batch (default 0.05)\n"
+        << "  --warmup=N           warm-up batches after calibration (default 1)\n"
+        << "  --repetitions=N      measured batches (default 5)\n"
+        << "  --cpu=N              pin the runner to CPU N; workers use N, N+1, ...\n"
+        << "  --format=FMT         text, json or csv (default text)\n"
+        << "  --out=PATH           write the report to PATH instead of stdout\n"
+        << "  --trace=PATH         write recorded trace events as Chrome trace JSON to PATH\n";
+}
+
+template <class T>
+bool parse_number(std::string_view text, T& value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        try {
+            value = static_cast<T>(std::stod(std::string{text}));
+            return true;
+        } catch (std::exception const&) {
+            return false;
+        }
+    } else {
+        auto const* end = text.data() + text.size();
+        auto [ptr, ec] = std::from_chars(text.data(), end, value);
+        return ec == std::errc{} && ptr == end;
+    }
+}
+
+bool parse_options(int argc, char** argv, options& opts) {
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg{argv[i]};
+        auto const eq = arg.find('=');
+        auto const key = arg.substr(0, eq);
+        auto const value = eq == std::string_view::npos ? std::string_view{} : arg.substr(eq + 1);
+
+        bool ok = true;
+        if (key == "--help" || key == "-h") {
+            print_usage(argv[0]);
+            std::exit(0);
+        } else if (key == "--list") {
+            opts.list = true;
+        } else if (key == "--filter") {
+            opts.filter = value;
+        } else if (key == "--iterations") {
+            ok = parse_number(value, opts.iterations);
+        } else if (key == "--min-time") {
+            ok = parse_number(value, opts.min_time);
+        } else if (key == "--warmup") {
+            ok = parse_number(value, opts.warmup);
+        } else if (key == "--repetitions") {
+            ok = parse_number(value, opts.repetitions) && opts.repetitions > 0;
+        } else if (key == "--cpu") {
+            ok = parse_number(value, opts.cpu);
+        } else if (key == "--out") {
+            opts.out = value;
+        } else if (key == "--trace") {
+            opts.trace = value;
+            ok = !value.empty();
+        } else if (key == "--format") {
+            if (value == "text") {
+                opts.format = output_format::text;
+            } else if (value == "json") {
+                opts.format = output_format::json;
+            } else if (value == "csv") {
+                opts.format = output_format::csv;
+            } else {
+                ok = false;
+            }
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::cerr << "invalid option: " << arg << "\n";
+            print_usage(argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+state run_batch(benchmark const& bench, std::vector<std::int64_t> const& args,
+                std::uint64_t iterations) {
+    state st{iterations, args, bench.uses_manual_time()};
+    try {
+        bench.fn()(st);
+    } catch (std::exception const& e) {
+        st.error(std::string{"exception: "} + e.what());
+    }
+    if (st.error_message().empty() && st.skip_reason().empty() && !st.loop_finished()) {
+        st.error("benchmark did not run its timed loop");
+    }
+    return st;
+}
+
+bool failed(state const& st) {
+    return !st.error_message().empty() || !st.skip_reason().empty();
+}
+
+void copy_status(state const& st, result& r) {
+    r.error = st.error_message();
+    r.skipped = st.skip_reason();
+}
+
+// Grows the iteration count until one batch takes at least `min_time`.
+std::uint64_t calibrate(benchmark const& bench, std::vector<std::int64_t> const& args,
+                        options const& opts, result& r) {
+    std::uint64_t n = 1;
+    for (;;) {
+        state st = run_batch(bench, args, n);
+        if (failed(st)) {
+            copy_status(st, r);
+            return 0;
+        }
+        double const t = st.elapsed_seconds();
+        if (t >= opts.min_time || n >= max_iterations) {
+            return n;
+        }
+        double const multiplier = t <= 0.0 ? 10.0 : std::min(10.0, opts.min_time * 1.4 / t);
+        n = std::min(max_iterations,
+                     std::max(n + 1, static_cast<std::uint64_t>(static_cast<double>(n) * multiplier)));
+    }
+}
+
+result measure(benchmark const& bench, std::vector<std::int64_t> const& args,
+               options const& opts) {
+    result r;
+    r.name = bench.display_name(args);
+    r.args = args;
+
+    std::uint64_t n = bench.fixed_iterations() ? bench.fixed_iterations() : opts.iterations;
+    if (n == 0) {
+        n = calibrate(bench, args, opts, r);
+        if (n == 0) {
+            return r;
+        }
+    }
+    r.iterations = n;
+
+    for (unsigned i = 0; i < opts.warmup; ++i) {
+        state st = run_batch(bench, args, n);
+        if (failed(st)) {
+            copy_status(st, r);
+            return r;
+        }
+    }
+
+    unsigned const reps = bench.fixed_repetitions() ? bench.fixed_repetitions() : opts.repetitions;
+    std::vector<double> ns_per_op;
+    ns_per_op.reserve(reps);
+    for (unsigned i = 0; i < reps; ++i) {
+        state st = run_batch(bench, args, n);
+        if (failed(st)) {
+            copy_status(st, r);
+            return r;
+        }
+        double const seconds = st.elapsed_seconds();
+        ns_per_op.push_back(seconds * 1e9 / static_cast<double>(n));
+
+        if (i + 1 == reps) {
+            for (auto const& [name, c] : st.counters()) {
+                double value = c.value;
+                if (c.kind == counter_kind::per_iteration) {
+                    value /= static_cast<double>(n);
+                } else if (c.kind == counter_kind::rate) {
+                    value = seconds > 0.0 ? value / seconds : 0.0;
+                }
+                r.counters[name] = value;
+            }
+            r.label = st.label();
+            double const per_op = static_cast<double>(n);
+            r.items_per_second = static_cast<double>(st.items_processed()) / per_op;
+            r.bytes_per_second = static_cast<double>(st.bytes_processed()) / per_op;
+        }
+    }
+    r.repetitions = reps;
+
+    std::vector<double> sorted = ns_per_op;
+    std::sort(sorted.begin(), sorted.end());
+    r.ns_min = sorted.front();
+    r.ns_max = sorted.back();
+    r.ns_median = sorted.size() % 2 ? sorted[sorted.size() / 2]
+                                    : (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2.0;
+    r.ns_mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+    double variance = 0.0;
+    for (double v : sorted) {
+        variance += (v - r.ns_mean) * (v - r.ns_mean);
+    }
+    r.ns_stddev = sorted.size() > 1 ? std::sqrt(variance / static_cast<double>(sorted.size() - 1)) : 0.0;
+
+    // Items and bytes were accumulated per iteration above; scale by the median time.
+    if (r.ns_median > 0.0) {
+        r.items_per_second *= 1e9 / r.ns_median;
+        r.bytes_per_second *= 1e9 / r.ns_median;
+    }
+    return r;
+}
+
+}  // namespace
+
+int run(int argc, char** argv) {
+    options opts;
+    if (!parse_options(argc, argv, opts)) {
+        return 2;
+    }
+
+    std::regex filter;
+    if (!opts.filter.empty()) {
+        try {
+            filter = std::regex{opts.filter};
+        } catch (std::regex_error const& e) {
+            std::cerr << "invalid --filter: " << e.what() << "\n";
+            return 2;
+        }
+    }
+
+    struct job {
+        benchmark const* bench;
+        std::vector<std::int64_t> args;
+        std::string name;
+    };
+    std::vector<job> jobs;
+    for (auto const& bench : registry()) {
+        auto sets = bench->arg_sets();
+        if (sets.empty()) {
+            sets.emplace_back();
+        }
+        for (auto& args : sets) {
+            auto name = bench->display_name(args);
+            if (opts.filter.empty() || std::regex_search(name, filter)) {
+                jobs.push_back({bench.get(), std::move(args), std::move(name)});
+            }
+        }
+    }
+
+    if (opts.list) {
+        for (auto const& j : jobs) {
+            std::cout << j.name << '\n';
+        }
+        return 0;
+    }
+
+    if (opts.cpu >= 0) {
+        if (!pin_current_thread(opts.cpu)) {
+            std::cerr << "warning: could not pin to cpu " << opts.cpu << ": " << std::strerror(errno)
+                      << "\n";
+        }
+        set_base_cpu(opts.cpu);
+    }
+
+    bool const progress = opts.format != output_format::text || !opts.out.empty();
+    std::vector<result> results;
+    results.reserve(jobs.size());
+    for (std::size_t i = 0; i < jobs.size(); ++i) {
+        if (progress) {
+            std::cerr << '[' << i + 1 << '/' << jobs.size() << "] " << jobs[i].name << std::endl;
+        }
+        results.push_back(measure(*jobs[i].bench, jobs[i].args, opts));
+    }
+
+    std::string executable = argv[0];
+    if (auto slash = executable.rfind('/'); slash != std::string::npos) {
+        executable.erase(0, slash + 1);
+    }
+    run_context const ctx = collect_context(executable);
+
+    std::ofstream file;
+    if (!opts.out.empty()) {
+        file.open(opts.out);
+        if (!file) {
+            std::cerr << "cannot open " << opts.out << " for writing\n";
+            return 2;
+        }
+    }
+    std::ostream& out = opts.out.empty() ? std::cout : file;
+    switch (opts.format) {
+    case output_format::text: write_text(out, ctx, opts, results); break;
+    case output_format::json: write_json(out, ctx, opts, results); break;
+    case output_format::csv: write_csv(out, results); break;
+    }
+
+    if (!opts.trace.empty()) {
+        if (!CPPLEARN_TRACE) {
+            std::cerr << "note: built without CPPLEARN_TRACE; CPPLEARN_TRACE_SCOPE recorded nothing\n";
+        }
+        if (!trace::write_chrome_trace(opts.trace)) {
+            std::cerr << "cannot write trace to " << opts.trace << "\n";
+            return 2;
+        }
+    }
+
+    bool const any_error = std::any_of(results.begin(), results.end(),
+                                       [](result const& r) { return !r.error.empty(); });
+    for (auto const& r : results) {
+        if (!r.error.empty()) {
+            std::cerr << r.name << ": " << r.error << "\n";
+        }
+    }
+    return any_error ? 1 : 0;
+}
+
+}  // namespace cpplearn::bench
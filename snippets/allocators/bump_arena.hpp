@@ -0,0 +1,109 @@
+// A bump-pointer arena and a std-compatible allocator on top.
+//
+// Allocation advances a pointer; deallocation does nothing; reset() rewinds
+// to the first chunk and keeps every chunk for reuse, so a steady-state
+// workload that resets between rounds never calls malloc.  Unlike
+// std::pmr::monotonic_buffer_resource it is not a memory_resource, so calls
+// through arena_allocator are inlined instead of dispatched virtually.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace allocators {
+
+class bump_arena {
+public:
+    explicit bump_arena(std::size_t chunk_size = 64 * 1024) : chunk_size_{chunk_size} {}
+
+    bump_arena(bump_arena const&) = delete;
+    bump_arena& operator=(bump_arena const&) = delete;
+
+    ~bump_arena() {
+        for (auto const& c : chunks_) {
+            ::operator delete(c.begin);
+        }
+    }
+
+    // Zero-byte requests take one byte, so they too get a distinct non-null
+    // pointer (a fresh arena would otherwise hand out its null cursor).
+    void* allocate(std::size_t size, std::size_t align) {
+        size += size == 0;
+        std::uintptr_t const aligned = (cursor_ + align - 1) & ~(std::uintptr_t{align} - 1);
+        if (aligned + size > end_) [[unlikely]] {
+            return allocate_slow(size, align);
+        }
+        cursor_ = aligned + size;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void reset() noexcept {
+        current_ = 0;
+        if (!chunks_.empty()) {
+            enter(0);
+        }
+    }
+
+    std::size_t chunk_count() const noexcept { return chunks_.size(); }
+
+private:
+    struct chunk {
+        std::byte* begin;
+        std::size_t size;
+    };
+
+    void enter(std::size_t index) noexcept {
+        current_ = index;
+        cursor_ = reinterpret_cast<std::uintptr_t>(chunks_[index].begin);
+        end_ = cursor_ + chunks_[index].size;
+    }
+
+    void* allocate_slow(std::size_t size, std::size_t align) {
+        // Move on to a chunk retained from before the last reset() if the
+        // request fits, otherwise append a new one.
+        std::size_t next = chunks_.empty() ? 0 : current_ + 1;
+        while (next < chunks_.size() && chunks_[next].size < size + align) {
+            ++next;
+        }
+        if (next == chunks_.size()) {
+            std::size_t const bytes = size + align > chunk_size_ ? size + align : chunk_size_;
+            chunks_.push_back({static_cast<std::byte*>(::operator new(bytes)), bytes});
+        }
+        enter(next);
+        return allocate(size, align);
+    }
+
+    std::size_t chunk_size_;
+    std::vector<chunk> chunks_;
+    std::size_t current_ = 0;
+    std::uintptr_t cursor_ = 0;
+    std::uintptr_t end_ = 0;
+};
+
+template <class T>
+class arena_allocator {
+public:
+    using value_type = T;
+
+    explicit arena_allocator(bump_arena& arena) noexcept : arena_{&arena} {}
+
+    template <class U>
+    arena_allocator(arena_allocator<U> const& other) noexcept : arena_{other.arena()} {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T*, std::size_t) noexcept {}
+
+    bump_arena* arena() const noexcept { return arena_; }
+
+    template <class U>
+    friend bool operator==(arena_allocator const& a, arena_allocator<U> const& b) noexcept {
+        return a.arena() == b.arena();
+    }
+
+private:
+    bump_arena* arena_;
+};
+
+}  // namespace allocators
@@ -0,0 +1,117 @@
+// A hand-written fixed-size block pool and a std-compatible allocator on top.
+//
+// All blocks have the same size, so allocation and deallocation are a pop and
+// a push on an intrusive free list.  Memory is carved from large chunks and is
+// only returned to the system when the pool is destroyed.  Not thread-safe:
+// use one pool per thread.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace allocators {
+
+class fixed_pool {
+public:
+    explicit fixed_pool(std::size_t block_size, std::size_t blocks_per_chunk = 1024)
+        : block_size_{round_up(block_size < sizeof(node) ? sizeof(node) : block_size)},
+          blocks_per_chunk_{blocks_per_chunk} {}
+
+    fixed_pool(fixed_pool const&) = delete;
+    fixed_pool& operator=(fixed_pool const&) = delete;
+
+    ~fixed_pool() {
+        for (void* chunk : chunks_) {
+            ::operator delete(chunk);
+        }
+    }
+
+    void* allocate() {
+        if (free_ == nullptr) [[unlikely]] {
+            refill();
+        }
+        node* block = free_;
+        free_ = block->next;
+        return block;
+    }
+
+    void deallocate(void* ptr) noexcept {
+        auto* block = static_cast<node*>(ptr);
+        block->next = free_;
+        free_ = block;
+    }
+
+    std::size_t block_size() const noexcept { return block_size_; }
+    std::size_t chunk_count() const noexcept { return chunks_.size(); }
+
+private:
+    struct node {
+        node* next;
+    };
+
+    static std::size_t round_up(std::size_t size) noexcept {
+        constexpr std::size_t align = alignof(std::max_align_t);
+        return (size + align - 1) / align * align;
+    }
+
+    void refill() {
+        auto* chunk = static_cast<std::byte*>(::operator new(block_size_ * blocks_per_chunk_));
+        chunks_.push_back(chunk);
+        // Thread the new blocks in address order so the first allocations are
+        // contiguous.
+        for (std::size_t i = blocks_per_chunk_; i-- > 0;) {
+            deallocate(chunk + i * block_size_);
+        }
+    }
+
+    std::size_t block_size_;
+    std::size_t blocks_per_chunk_;
+    node* free_ = nullptr;
+    std::vector<void*> chunks_;
+};
+
+// Serves single-object requests that fit a pool block from the pool and
+// everything else (e.g. hash bucket arrays) from operator new.
+template <class T>
+class pool_allocator {
+public:
+    using value_type = T;
+
+    explicit pool_allocator(fixed_pool& pool) noexcept : pool_{&pool} {}
+
+    template <class U>
+    pool_allocator(pool_allocator<U> const& other) noexcept : pool_{other.pool()} {}
+
+    T* allocate(std::size_t n) {
+        if (from_pool(n)) {
+            return static_cast<T*>(pool_->allocate());
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        if (from_pool(n)) {
+            pool_->deallocate(ptr);
+        } else {
+            ::operator delete(ptr);
+        }
+    }
+
+    fixed_pool* pool() const noexcept { return pool_; }
+
+    template <class U>
+    friend bool operator==(pool_allocator const& a, pool_allocator<U> const& b) noexcept {
+        return a.pool() == b.pool();
+    }
+
+private:
+    bool from_pool(std::size_t n) const noexcept {
+        return n == 1 && sizeof(T) <= pool_->block_size() && alignof(T) <= alignof(std::max_align_t);
+    }
+
+    fixed_pool* pool_;
+};
+
+}  // namespace allocators
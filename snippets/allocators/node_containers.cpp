@@ -0,0 +1,337 @@
+// Node-based containers on different memory resources.
+//
+// One iteration builds a container of n elements, erases every other key,
+// re-inserts them and destroys the container: 2n allocation-bound operations.
+// Every thread runs its own container on its own resource (the intended use
+// of the unsynchronized resources), except `sync_pool_shared`, where all
+// threads share one std::pmr::synchronized_pool_resource.
+//
+// Strategies:
+//   std_allocator     std::allocator, i.e. malloc
+//   pmr_new_delete    polymorphic_allocator over new_delete_resource: the cost
+//                     of virtual dispatch alone
+//   pmr_monotonic     monotonic_buffer_resource over a reused buffer, rebuilt
+//                     every iteration; frees are no-ops
+//   pmr_unsync_pool   unsynchronized_pool_resource kept across iterations
+//   sync_pool_shared  one synchronized_pool_resource for all threads
+//   fixed_pool        hand-written free-list pool (fixed_pool.hpp)
+//   bump_arena        hand-written arena, reset every iteration (bump_arena.hpp)
+
+#include "bump_arena.hpp"
+#include "fixed_pool.hpp"
+
+#include <cpplearn/bench.hpp>
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <new>
+#include <memory_resource>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+
+template <std::size_t Size>
+struct blob {
+    std::array<char, Size> bytes{};
+};
+
+// Rough per-element footprint including node headers, used to size buffers.
+template <std::size_t Size>
+constexpr std::size_t node_estimate = Size + 64;
+
+struct std_strategy {
+    static constexpr char const* name = "std_allocator";
+    template <class T>
+    using allocator = std::allocator<T>;
+
+    struct shared {};
+    class thread_state {
+    public:
+        thread_state(shared&, std::size_t) {}
+        void begin() {}
+        void end() {}
+        template <class T>
+        allocator<T> get() {
+            return {};
+        }
+    };
+};
+
+struct pmr_new_delete_strategy {
+    static constexpr char const* name = "pmr_new_delete";
+    template <class T>
+    using allocator = std::pmr::polymorphic_allocator<T>;
+
+    struct shared {};
+    class thread_state {
+    public:
+        thread_state(shared&, std::size_t) {}
+        void begin() {}
+        void end() {}
+        template <class T>
+        allocator<T> get() {
+            return {std::pmr::new_delete_resource()};
+        }
+    };
+};
+
+struct pmr_monotonic_strategy {
+    static constexpr char const* name = "pmr_monotonic";
+    template <class T>
+    using allocator = std::pmr::polymorphic_allocator<T>;
+
+    struct shared {};
+    class thread_state {
+    public:
+        thread_state(shared&, std::size_t bytes) : buffer_(bytes) {}
+        void begin() { resource_.emplace(buffer_.data(), buffer_.size()); }
+        void end() { resource_.reset(); }
+        template <class T>
+        allocator<T> get() {
+            return {&*resource_};
+        }
+
+    private:
+        std::vector<std::byte> buffer_;
+        std::optional<std::pmr::monotonic_buffer_resource> resource_;
+    };
+};
+
+struct pmr_unsync_pool_strategy {
+    static constexpr char const* name = "pmr_unsync_pool";
+    template <class T>
+    using allocator = std::pmr::polymorphic_allocator<T>;
+
+    struct shared {};
+    class thread_state {
+    public:
+        thread_state(shared&, std::size_t) {}
+        void begin() {}
+        void end() {}
+        template <class T>
+        allocator<T> get() {
+            return {&resource_};
+        }
+
+    private:
+        std::pmr::unsynchronized_pool_resource resource_;
+    };
+};
+
+struct sync_pool_shared_strategy {
+    static constexpr char const* name = "sync_pool_shared";
+    template <class T>
+    using allocator = std::pmr::polymorphic_allocator<T>;
+
+    struct shared {
+        std::pmr::synchronized_pool_resource resource;
+    };
+    class thread_state {
+    public:
+        thread_state(shared& s, std::size_t) : resource_{&s.resource} {}
+        void begin() {}
+        void end() {}
+        template <class T>
+        allocator<T> get() {
+            return {resource_};
+        }
+
+    private:
+        std::pmr::memory_resource* resource_;
+    };
+};
+
+template <std::size_t BlockSize>
+struct fixed_pool_strategy {
+    static constexpr char const* name = "fixed_pool";
+    template <class T>
+    using allocator = allocators::pool_allocator<T>;
+
+    struct shared {};
+    class thread_state {
+    public:
+        thread_state(shared&, std::size_t) : pool_{BlockSize} {}
+        void begin() {}
+        void end() {}
+        template <class T>
+        allocator<T> get() {
+            return allocator<T>{pool_};
+        }
+
+    private:
+        allocators::fixed_pool pool_;
+    };
+};
+
+struct bump_arena_strategy {
+    static constexpr char const* name = "bump_arena";
+    template <class T>
+    using allocator = allocators::arena_allocator<T>;
+
+    struct shared {};
+    class thread_state {
+    public:
+        thread_state(shared&, std::size_t bytes) : arena_{bytes} {}
+        void begin() {}
+        void end() { arena_.reset(); }
+        template <class T>
+        allocator<T> get() {
+            return allocator<T>{arena_};
+        }
+
+    private:
+        allocators::bump_arena arena_;
+    };
+};
+
+// Used here rather than in a header: GCC warns about the constant in
+// headers, where it could leak into an ABI.
+constexpr std::size_t line = std::hardware_destructive_interference_size;
+
+template <class T>
+struct alignas(line) padded {
+    template <class... Args>
+    explicit padded(Args&&... args) : value(std::forward<Args>(args)...) {}
+    T value;
+};
+
+enum class container { map, list, unordered_map };
+
+constexpr char const* container_name(container kind) {
+    switch (kind) {
+    case container::map: return "map";
+    case container::list: return "list";
+    case container::unordered_map: return "unordered_map";
+    }
+    return "?";
+}
+
+template <container Kind, class Strategy, class Value>
+auto make_container(typename Strategy::thread_state& ts) {
+    using pair = std::pair<int const, Value>;
+    if constexpr (Kind == container::map) {
+        using alloc = typename Strategy::template allocator<pair>;
+        return std::map<int, Value, std::less<int>, alloc>{ts.template get<pair>()};
+    } else if constexpr (Kind == container::unordered_map) {
+        using alloc = typename Strategy::template allocator<pair>;
+        return std::unordered_map<int, Value, std::hash<int>, std::equal_to<int>, alloc>{
+            ts.template get<pair>()};
+    } else {
+        using alloc = typename Strategy::template allocator<Value>;
+        return std::list<Value, alloc>{ts.template get<Value>()};
+    }
+}
+
+template <container Kind, class Container>
+void churn(Container& c, std::vector<int> const& keys) {
+    if constexpr (Kind == container::list) {
+        for (int key : keys) {
+            c.emplace_back().bytes[0] = static_cast<char>(key);
+        }
+        bool erase = true;
+        for (auto it = c.begin(); it != c.end(); erase = !erase) {
+            it = erase ? c.erase(it) : std::next(it);
+        }
+        for (std::size_t i = 0; i < keys.size(); i += 2) {
+            c.emplace_back().bytes[0] = static_cast<char>(keys[i]);
+        }
+    } else {
+        for (int key : keys) {
+            c.try_emplace(key);
+        }
+        for (std::size_t i = 0; i < keys.size(); i += 2) {
+            c.erase(keys[i]);
+        }
+        for (std::size_t i = 0; i < keys.size(); i += 2) {
+            c.try_emplace(keys[i]);
+        }
+    }
+}
+
+template <container Kind, class Strategy, std::size_t ValueSize>
+void bm_churn(state& st) {
+    auto const n = static_cast<std::size_t>(st.arg(0));
+    auto const threads = static_cast<unsigned>(st.arg(1));
+
+    std::vector<int> keys(n);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937{42});
+
+    // Every state is built and put through one untimed round here, so the
+    // buffers, pool chunks and arena chunks the strategies keep across
+    // iterations exist before the timed threads start.  Each sits on its own
+    // cache line so that neighbouring threads' hot allocator state does not
+    // false-share; all of it is first touched by this thread, which only
+    // matters across NUMA nodes.  A deque, since thread_state is neither
+    // copyable nor movable.
+    typename Strategy::shared shared;
+    std::deque<padded<typename Strategy::thread_state>> states;
+    auto const round = [&](typename Strategy::thread_state& ts) {
+        ts.begin();
+        {
+            auto c = make_container<Kind, Strategy, blob<ValueSize>>(ts);
+            churn<Kind>(c, keys);
+            do_not_optimize(c);
+        }
+        ts.end();
+    };
+    for (unsigned t = 0; t < threads; ++t) {
+        round(states.emplace_back(shared, 2 * n * node_estimate<ValueSize>).value);
+    }
+    st.run_threads(threads, [&](unsigned thread, std::uint64_t iterations) {
+        auto& ts = states[thread].value;
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            round(ts);
+        }
+    });
+    st.set_items_processed(st.iterations() * threads * 2 * n);
+}
+
+template <container Kind, class Strategy, std::size_t ValueSize>
+void register_churn() {
+    std::string name = std::string{"churn/"} + container_name(Kind) + "/" + Strategy::name +
+                       "/obj:" + std::to_string(ValueSize);
+    cpplearn::bench::register_benchmark(std::move(name), bm_churn<Kind, Strategy, ValueSize>)
+        ->args_product({{4096}, cpplearn::bench::thread_counts()})
+        ->arg_names({"n", "threads"});
+}
+
+template <container Kind, std::size_t ValueSize>
+void register_strategies() {
+    register_churn<Kind, std_strategy, ValueSize>();
+    register_churn<Kind, pmr_new_delete_strategy, ValueSize>();
+    register_churn<Kind, pmr_monotonic_strategy, ValueSize>();
+    register_churn<Kind, pmr_unsync_pool_strategy, ValueSize>();
+    register_churn<Kind, sync_pool_shared_strategy, ValueSize>();
+    register_churn<Kind, fixed_pool_strategy<node_estimate<ValueSize>>, ValueSize>();
+    register_churn<Kind, bump_arena_strategy, ValueSize>();
+}
+
+template <container Kind>
+void register_sizes() {
+    register_strategies<Kind, 16>();
+    register_strategies<Kind, 64>();
+    register_strategies<Kind, 256>();
+}
+
+[[maybe_unused]] bool const registered = [] {
+    register_sizes<container::map>();
+    register_sizes<container::list>();
+    register_sizes<container::unordered_map>();
+    return true;
+}();
+
+}  // namespace
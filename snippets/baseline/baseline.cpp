@@ -0,0 +1,60 @@
+// Baseline costs of the harness itself.  Subtract these from any snippet whose
+// per-iteration work is only a few nanoseconds.
+
+#include <cpplearn/bench.hpp>
+
+#include <chrono>
+#include <ctime>
+
+namespace {
+
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+
+// An empty timed loop: the floor for anything measured with the harness.
+void bm_empty_loop(state& st) {
+    for (auto _ : st) {
+    }
+}
+CPPLEARN_BENCHMARK(bm_empty_loop);
+
+// do_not_optimize on a register value: the cost of defeating the optimizer.
+void bm_do_not_optimize(state& st) {
+    int value = 0;
+    for (auto _ : st) {
+        do_not_optimize(value);
+    }
+}
+CPPLEARN_BENCHMARK(bm_do_not_optimize);
+
+// pause_timing/resume_timing pair: why per-iteration setup should be avoided.
+void bm_pause_resume(state& st) {
+    for (auto _ : st) {
+        st.pause_timing();
+        st.resume_timing();
+    }
+}
+CPPLEARN_BENCHMARK(bm_pause_resume);
+
+void bm_steady_clock_now(state& st) {
+    for (auto _ : st) {
+        do_not_optimize(std::chrono::steady_clock::now());
+    }
+}
+CPPLEARN_BENCHMARK(bm_steady_clock_now);
+
+void bm_clock_gettime(state& st) {
+    int const clock = static_cast<int>(st.arg(0));
+    timespec ts{};
+    for (auto _ : st) {
+        ::clock_gettime(clock, &ts);
+        do_not_optimize(ts);
+    }
+}
+CPPLEARN_BENCHMARK(bm_clock_gettime)
+    ->arg(CLOCK_MONOTONIC)
+    ->arg(CLOCK_MONOTONIC_COARSE)
+    ->arg(CLOCK_THREAD_CPUTIME_ID)
+    ->arg_names({"clock_id"});
+
+}  // namespace
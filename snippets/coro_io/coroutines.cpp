@@ -0,0 +1,98 @@
+// What a coroutine costs before any I/O is involved.
+//
+// call:          a plain out-of-line function call, the floor.
+// task_await:    co_await of a task that returns immediately: one frame
+//                allocation, a resume and return, one frame destruction.
+// task_chain:    the same through a chain of `depth` nested tasks.
+// yield_resume:  suspend, go through the executor's run queue, resume; the
+//                per-hop cost of a scheduler built on coroutine handles.
+//
+// allocs/op shows the frame allocations the compiler did not elide.
+
+#include "executor.hpp"
+#include "task.hpp"
+
+#include <cpplearn/alloc_counter.hpp>
+#include <cpplearn/bench.hpp>
+
+#include <cstdint>
+
+namespace {
+
+using cpplearn::bench::alloc_scope;
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+using coro_io::task;
+
+[[gnu::noinline]] int add_one(int x) {
+    return x + 1;
+}
+
+void bm_call(state& st) {
+    int x = 0;
+    alloc_scope allocs;
+    for (auto _ : st) {
+        x = add_one(x);
+        do_not_optimize(x);
+    }
+    allocs.report(st);
+}
+CPPLEARN_BENCHMARK(bm_call);
+
+task<int> add_one_task(int x) {
+    co_return x + 1;
+}
+
+task<void> await_loop(state& st) {
+    int x = 0;
+    for (auto _ : st) {
+        x = co_await add_one_task(x);
+        do_not_optimize(x);
+    }
+}
+
+void bm_task_await(state& st) {
+    alloc_scope allocs;
+    coro_io::sync_wait(await_loop(st));
+    allocs.report(st);
+}
+CPPLEARN_BENCHMARK(bm_task_await);
+
+task<int> nested(int depth, int x) {
+    if (depth == 0) {
+        co_return x + 1;
+    }
+    co_return co_await nested(depth - 1, x);
+}
+
+task<void> chain_loop(state& st, int depth) {
+    int x = 0;
+    for (auto _ : st) {
+        x = co_await nested(depth, x);
+        do_not_optimize(x);
+    }
+}
+
+void bm_task_chain(state& st) {
+    alloc_scope allocs;
+    coro_io::sync_wait(chain_loop(st, static_cast<int>(st.arg(0))));
+    allocs.report(st);
+}
+CPPLEARN_BENCHMARK(bm_task_chain)->args_product({{1, 4, 16}})->arg_names({"depth"});
+
+task<void> yield_loop(coro_io::executor& ex, state& st) {
+    for (auto _ : st) {
+        co_await ex.yield();
+    }
+}
+
+void bm_yield_resume(state& st) {
+    coro_io::executor ex;
+    ex.spawn(yield_loop(ex, st));
+    alloc_scope allocs;
+    ex.run_ready();
+    allocs.report(st);
+}
+CPPLEARN_BENCHMARK(bm_yield_resume);
+
+}  // namespace
@@ -0,0 +1,229 @@
+// Loopback echo: coroutine servers on epoll and io_uring vs a blocking
+// thread-per-connection server.
+//
+// The client side is the same for every server: one thread running an epoll
+// reactor with one coroutine per connection, each sending a 64-byte message,
+// waiting for the echo and recording the round trip.  One iteration is one
+// request; requests are shared out among the connections as they become free.
+// Connection setup and teardown are outside the timed region.  items/s is
+// requests per second; p50_us and p99_us are round-trip latency percentiles.
+//
+// Client and server run in the same process and, on a small machine, on the
+// same cores, so absolute numbers include the scheduler hand-off between
+// them; the comparison between server models is what carries over.
+
+#include "epoll_reactor.hpp"
+#include "socket.hpp"
+#include "task.hpp"
+#include "uring_reactor.hpp"
+
+#include <cpplearn/bench.hpp>
+
+#include <sys/socket.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::state;
+using namespace coro_io;
+
+constexpr std::size_t message_size = 64;
+
+template <class Reactor>
+task<void> echo_session(Reactor& r, int fd) {
+    std::array<char, 4096> buffer;
+    for (;;) {
+        ssize_t const n = co_await r.recv(fd, buffer.data(), buffer.size());
+        if (n <= 0) {
+            break;
+        }
+        ssize_t sent = 0;
+        while (sent < n) {
+            ssize_t const w = co_await r.send(fd, buffer.data() + sent, static_cast<std::size_t>(n - sent));
+            if (w <= 0) {
+                r.close(fd);
+                co_return;
+            }
+            sent += w;
+        }
+    }
+    r.close(fd);
+}
+
+// Accepts exactly `connections` clients, so the reactor runs out of work and
+// returns once they have all disconnected.
+template <class Reactor>
+task<void> echo_server(Reactor& r, int listen_fd, unsigned connections) {
+    for (unsigned i = 0; i < connections; ++i) {
+        ssize_t const fd = co_await r.accept(listen_fd);
+        if (fd < 0) {
+            co_return;
+        }
+        r.spawn(echo_session(r, static_cast<int>(fd)));
+    }
+}
+
+void blocking_session(unique_fd fd) {
+    std::array<char, 4096> buffer;
+    for (;;) {
+        ssize_t const n = ::recv(fd.get(), buffer.data(), buffer.size(), 0);
+        if (n <= 0) {
+            return;
+        }
+        for (ssize_t sent = 0; sent < n;) {
+            ssize_t const w = ::send(fd.get(), buffer.data() + sent, static_cast<std::size_t>(n - sent), MSG_NOSIGNAL);
+            if (w <= 0) {
+                return;
+            }
+            sent += w;
+        }
+    }
+}
+
+void thread_per_connection_server(int listen_fd, unsigned connections) {
+    std::vector<std::thread> sessions;
+    for (unsigned i = 0; i < connections; ++i) {
+        int const fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            break;
+        }
+        set_nodelay(fd);
+        sessions.emplace_back(blocking_session, unique_fd{fd});
+    }
+    for (auto& t : sessions) {
+        t.join();
+    }
+}
+
+struct load {
+    std::uint64_t remaining;
+    std::vector<std::uint64_t> latencies_ns;
+    std::uint64_t failures = 0;
+};
+
+task<void> client_session(epoll_reactor& r, int fd, load& l, unsigned id) {
+    std::array<char, message_size> out;
+    std::array<char, message_size> in;
+    while (l.remaining > 0) {
+        --l.remaining;
+        std::memset(out.data(), static_cast<int>('a' + (l.remaining + id) % 26), out.size());
+        auto const start = std::chrono::steady_clock::now();
+
+        bool ok = true;
+        for (std::size_t done = 0; ok && done < out.size();) {
+            ssize_t const w = co_await r.send(fd, out.data() + done, out.size() - done);
+            ok = w > 0;
+            done += ok ? static_cast<std::size_t>(w) : 0;
+        }
+        for (std::size_t done = 0; ok && done < in.size();) {
+            ssize_t const n = co_await r.recv(fd, in.data() + done, in.size() - done);
+            ok = n > 0;
+            done += ok ? static_cast<std::size_t>(n) : 0;
+        }
+        if (!ok || in != out) {
+            ++l.failures;
+            break;
+        }
+        auto const elapsed = std::chrono::steady_clock::now() - start;
+        l.latencies_ns.push_back(static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+    // The fd itself belongs to bm_echo; end of stream is enough for the server.
+    ::shutdown(fd, SHUT_WR);
+}
+
+double percentile_us(std::vector<std::uint64_t>& samples, double p) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    auto const k = static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(k), samples.end());
+    return static_cast<double>(samples[k]) / 1000.0;
+}
+
+enum class server_model { epoll_coroutines, uring_coroutines, thread_per_connection };
+
+template <server_model Model>
+void bm_echo(state& st) {
+    auto const connections = static_cast<unsigned>(st.arg(0));
+    listener l = listen_loopback();
+
+    std::optional<epoll_reactor> epoll_server;
+    std::optional<uring_reactor> uring_server;
+    if constexpr (Model == server_model::epoll_coroutines) {
+        set_nonblocking(l.fd.get());
+        epoll_server.emplace();
+        epoll_server->spawn(echo_server(*epoll_server, l.fd.get(), connections));
+    } else if constexpr (Model == server_model::uring_coroutines) {
+        try {
+            uring_server.emplace();
+        } catch (std::system_error const& e) {
+            st.skip(std::string{"io_uring unavailable: "} + e.what());
+            return;
+        }
+        uring_server->spawn(echo_server(*uring_server, l.fd.get(), connections));
+    }
+    // The clients connect before the server thread starts (the listen
+    // backlog holds them), so nothing that can throw runs while it is
+    // joinable except the timed run itself.
+    epoll_reactor client;
+    load work{st.iterations(), {}};
+    work.latencies_ns.reserve(st.iterations());
+    std::vector<unique_fd> client_fds;
+    for (unsigned i = 0; i < connections; ++i) {
+        unique_fd& fd = client_fds.emplace_back(connect_loopback(l.port));
+        set_nonblocking(fd.get());
+        client.spawn(client_session(client, fd.get(), work, i));
+    }
+
+    std::thread server{[&] {
+        if constexpr (Model == server_model::epoll_coroutines) {
+            epoll_server->run();
+        } else if constexpr (Model == server_model::uring_coroutines) {
+            uring_server->run();
+        } else {
+            thread_per_connection_server(l.fd.get(), connections);
+        }
+    }};
+
+    try {
+        st.run_threads(1, [&](unsigned, std::uint64_t) { client.run(); });
+    } catch (...) {
+        // Hang up on every session so the server runs out of work.
+        for (auto const& fd : client_fds) {
+            ::shutdown(fd.get(), SHUT_RDWR);
+        }
+        server.join();
+        throw;
+    }
+    server.join();
+
+    if (work.failures != 0 || work.latencies_ns.size() != st.iterations()) {
+        st.error("echo mismatch or connection failure");
+        return;
+    }
+    st.set_items_processed(st.iterations());
+    st.set_counter("p50_us", percentile_us(work.latencies_ns, 0.50));
+    st.set_counter("p99_us", percentile_us(work.latencies_ns, 0.99));
+}
+
+CPPLEARN_BENCHMARK_NAMED("echo/epoll_coroutines", bm_echo<server_model::epoll_coroutines>)
+    ->args_product({{1, 8, 64}})
+    ->arg_names({"conns"});
+CPPLEARN_BENCHMARK_NAMED("echo/uring_coroutines", bm_echo<server_model::uring_coroutines>)
+    ->args_product({{1, 8, 64}})
+    ->arg_names({"conns"});
+CPPLEARN_BENCHMARK_NAMED("echo/thread_per_connection", bm_echo<server_model::thread_per_connection>)
+    ->args_product({{1, 8, 64}})
+    ->arg_names({"conns"});
+
+}  // namespace
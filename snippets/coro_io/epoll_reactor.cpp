@@ -0,0 +1,103 @@
+#include "epoll_reactor.hpp"
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+
+namespace coro_io {
+
+bool epoll_reactor::operation::perform() noexcept {
+    ssize_t n = 0;
+    switch (op) {
+    case kind::accept:
+        n = ::accept4(fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (n >= 0) {
+            int const on = 1;
+            ::setsockopt(static_cast<int>(n), IPPROTO_TCP, TCP_NODELAY, &on, sizeof on);
+        }
+        break;
+    case kind::recv:
+        n = ::recv(fd, buffer, length, 0);
+        break;
+    case kind::send:
+        n = ::send(fd, buffer, length, MSG_NOSIGNAL);
+        break;
+    }
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return false;
+        }
+        n = -errno;
+    }
+    result = n;
+    return true;
+}
+
+epoll_reactor::epoll_reactor() : epoll_{check(::epoll_create1(EPOLL_CLOEXEC), "epoll_create1")} {}
+
+void epoll_reactor::park(operation& op) {
+    if (static_cast<std::size_t>(op.fd) >= fds_.size()) {
+        fds_.resize(static_cast<std::size_t>(op.fd) + 1);
+    }
+    fd_state& s = fds_[static_cast<std::size_t>(op.fd)];
+    if (!s.registered) {
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        ev.data.fd = op.fd;
+        check(::epoll_ctl(epoll_.get(), EPOLL_CTL_ADD, op.fd, &ev), "epoll_ctl");
+        s.registered = true;
+    }
+    (op.op == operation::kind::send ? s.writer : s.reader) = &op;
+    ++waiting_;
+}
+
+void epoll_reactor::close(int fd) {
+    if (static_cast<std::size_t>(fd) < fds_.size()) {
+        fds_[static_cast<std::size_t>(fd)] = {};
+    }
+    ::close(fd);
+}
+
+void epoll_reactor::retry(operation*& slot) {
+    if (slot != nullptr && slot->perform()) {
+        post(slot->waiter);
+        slot = nullptr;
+        --waiting_;
+    }
+}
+
+void epoll_reactor::run() {
+    epoll_event events[64];
+    for (;;) {
+        run_ready();
+        if (waiting_ == 0) {
+            return;
+        }
+        int const n = ::epoll_wait(epoll_.get(), events, 64, -1);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            check(n, "epoll_wait");
+        }
+        // Woken coroutines are queued rather than resumed here: they may
+        // close or register fds, which would invalidate `fds_` references.
+        for (int i = 0; i < n; ++i) {
+            fd_state& s = fds_[static_cast<std::size_t>(events[i].data.fd)];
+            std::uint32_t const e = events[i].events;
+            if (e & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                retry(s.reader);
+            }
+            if (e & (EPOLLOUT | EPOLLHUP | EPOLLERR)) {
+                retry(s.writer);
+            }
+        }
+    }
+}
+
+}  // namespace coro_io
@@ -0,0 +1,86 @@
+// Readiness-based socket awaitables on epoll.
+//
+// An operation first tries its syscall directly: a recv on a socket that
+// already has data completes without suspending, which is the common case
+// under load.  Only on EAGAIN does the coroutine park itself on the fd and
+// return to the event loop; when epoll reports the fd ready the loop retries
+// the syscall and queues the coroutine once it succeeds.
+//
+// Each fd is registered once, edge-triggered, for both directions, so parking
+// costs no epoll_ctl call after the first.  At most one reader and one writer
+// may wait on an fd at a time.  All fds passed in must be non-blocking.
+#pragma once
+
+#include "executor.hpp"
+#include "socket.hpp"
+
+#include <sys/types.h>
+
+#include <coroutine>
+#include <cstddef>
+#include <vector>
+
+namespace coro_io {
+
+class epoll_reactor : public executor {
+    struct operation {
+        enum class kind { accept, recv, send };
+
+        // Tries the syscall; false if it would block.
+        bool perform() noexcept;
+
+        kind op;
+        int fd;
+        void* buffer;
+        std::size_t length;
+        ssize_t result = 0;
+        std::coroutine_handle<> waiter;
+    };
+
+    struct awaiter {
+        bool await_ready() noexcept { return op.perform(); }
+        void await_suspend(std::coroutine_handle<> h) {
+            op.waiter = h;
+            reactor->park(op);
+        }
+        ssize_t await_resume() const noexcept { return op.result; }
+
+        epoll_reactor* reactor;
+        operation op;
+    };
+
+public:
+    epoll_reactor();
+
+    // Resolves to the accepted (non-blocking) fd or -errno.
+    awaiter accept(int fd) noexcept { return {this, {operation::kind::accept, fd, nullptr, 0, 0, {}}}; }
+    // Resolve to the byte count (0 at end of stream) or -errno.
+    awaiter recv(int fd, void* buffer, std::size_t length) noexcept {
+        return {this, {operation::kind::recv, fd, buffer, length, 0, {}}};
+    }
+    awaiter send(int fd, void const* buffer, std::size_t length) noexcept {
+        return {this, {operation::kind::send, fd, const_cast<void*>(buffer), length, 0, {}}};
+    }
+
+    // Closes an fd with no operation waiting on it.
+    void close(int fd);
+
+    // Runs until no coroutine is queued and no operation is waiting.
+    void run();
+
+private:
+    struct fd_state {
+        operation* reader = nullptr;
+        operation* writer = nullptr;
+        bool registered = false;
+    };
+
+    void park(operation& op);
+    void retry(operation*& slot);
+
+    unique_fd epoll_;
+    std::vector<fd_state> fds_;
+    std::size_t waiting_ = 0;
+};
+
+}  // namespace coro_io
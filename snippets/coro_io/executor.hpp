@@ -0,0 +1,53 @@
+// A single-threaded run queue of coroutine handles.
+//
+// `spawn` starts a task<void> detached, `post` queues any handle and `yield`
+// reschedules the current coroutine behind everything already queued.  The
+// reactors derive from this and run the queue between polls.
+#pragma once
+
+#include "task.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+
+namespace coro_io {
+
+class executor {
+public:
+    executor() = default;
+    executor(executor const&) = delete;
+    executor& operator=(executor const&) = delete;
+
+    void post(std::coroutine_handle<> h) { ready_.push_back(h); }
+
+    void spawn(task<void> t) { post(make_detached(std::move(t)).handle()); }
+
+    auto yield() noexcept {
+        struct awaiter {
+            executor* ex;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) const { ex->post(h); }
+            void await_resume() const noexcept {}
+        };
+        return awaiter{this};
+    }
+
+    // Resumes queued coroutines until the queue is empty, including any that
+    // are queued while draining.  Returns how many were resumed.
+    std::size_t run_ready() {
+        std::size_t resumed = 0;
+        while (!ready_.empty()) {
+            auto h = ready_.front();
+            ready_.pop_front();
+            h.resume();
+            ++resumed;
+        }
+        return resumed;
+    }
+
+private:
+    std::deque<std::coroutine_handle<>> ready_;
+};
+
+}  // namespace coro_io
@@ -0,0 +1,73 @@
+#include "socket.hpp"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+
+namespace coro_io {
+
+namespace {
+
+sockaddr_in loopback(std::uint16_t port) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return addr;
+}
+
+}  // namespace
+
+void unique_fd::reset(int fd) noexcept {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+    fd_ = fd;
+}
+
+int check(int result, char const* what) {
+    if (result < 0) {
+        throw std::system_error{errno, std::generic_category(), what};
+    }
+    return result;
+}
+
+listener listen_loopback(int backlog) {
+    listener l;
+    l.fd.reset(check(::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0), "socket"));
+    int const on = 1;
+    check(::setsockopt(l.fd.get(), SOL_SOCKET, SO_REUSEADDR, &on, sizeof on), "setsockopt");
+    sockaddr_in addr = loopback(0);
+    check(::bind(l.fd.get(), reinterpret_cast<sockaddr*>(&addr), sizeof addr), "bind");
+    check(::listen(l.fd.get(), backlog), "listen");
+    socklen_t len = sizeof addr;
+    check(::getsockname(l.fd.get(), reinterpret_cast<sockaddr*>(&addr), &len), "getsockname");
+    l.port = ntohs(addr.sin_port);
+    return l;
+}
+
+unique_fd connect_loopback(std::uint16_t port) {
+    unique_fd fd{check(::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0), "socket")};
+    sockaddr_in addr = loopback(port);
+    check(::connect(fd.get(), reinterpret_cast<sockaddr*>(&addr), sizeof addr), "connect");
+    set_nodelay(fd.get());
+    return fd;
+}
+
+void set_nonblocking(int fd) {
+    int const flags = check(::fcntl(fd, F_GETFL), "fcntl");
+    check(::fcntl(fd, F_SETFL, flags | O_NONBLOCK), "fcntl");
+}
+
+void set_nodelay(int fd) {
+    int const on = 1;
+    check(::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof on), "setsockopt");
+}
+
+}  // namespace coro_io
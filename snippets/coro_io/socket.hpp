@@ -0,0 +1,54 @@
+// Loopback TCP sockets for the echo benchmarks.
+//
+// Setup errors throw std::system_error (the harness reports them as a failed
+// run); the asynchronous operations themselves return -errno instead, so a
+// coroutine can react to a reset connection without unwinding.
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+namespace coro_io {
+
+// Owns a file descriptor.
+class unique_fd {
+public:
+    unique_fd() = default;
+    explicit unique_fd(int fd) noexcept : fd_{fd} {}
+    unique_fd(unique_fd&& other) noexcept : fd_{std::exchange(other.fd_, -1)} {}
+    unique_fd& operator=(unique_fd&& other) noexcept {
+        if (this != &other) {
+            reset(std::exchange(other.fd_, -1));
+        }
+        return *this;
+    }
+    ~unique_fd() { reset(); }
+
+    int get() const noexcept { return fd_; }
+    int release() noexcept { return std::exchange(fd_, -1); }
+    void reset(int fd = -1) noexcept;
+    explicit operator bool() const noexcept { return fd_ >= 0; }
+
+private:
+    int fd_ = -1;
+};
+
+// Throws std::system_error built from errno when `result` is negative.
+int check(int result, char const* what);
+
+// A listening socket on 127.0.0.1 with a kernel-chosen port.
+struct listener {
+    unique_fd fd;
+    std::uint16_t port = 0;
+};
+
+listener listen_loopback(int backlog = 1024);
+
+// Blocking connect to 127.0.0.1:`port`, with Nagle disabled so small echo
+// messages are sent immediately.
+unique_fd connect_loopback(std::uint16_t port);
+
+void set_nonblocking(int fd);
+void set_nodelay(int fd);
+
+}  // namespace coro_io
@@ -0,0 +1,185 @@
+// A lazy coroutine task and a fire-and-forget wrapper.
+//
+// `task<T>` does not start until it is awaited.  Awaiting it resumes the task
+// right inside await_suspend; if the task runs to completion there, the
+// awaiter is not suspended at all, so a completed co_await costs roughly one
+// call and one return.  If the task suspends instead (on I/O), whoever later
+// resumes it also resumes the awaiter from its final_suspend.
+//
+// Symmetric transfer (returning the continuation's handle from
+// final_suspend) would be shorter, but it relies on a tail call that GCC only
+// emits with optimization on and without ASan; otherwise a loop of awaits that
+// complete synchronously grows the stack until it overflows.
+//
+// Every task call allocates its frame on the heap unless the compiler can
+// prove the frame does not outlive the caller (HALO).  GCC 12 never does that,
+// and the `coroutines` benchmarks report the allocation per call.
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace coro_io {
+
+template <class T>
+class task;
+
+namespace detail {
+
+// Where the awaiter is relative to the task.  Single-threaded executors
+// only, so a plain enum suffices.
+enum class await_state { idle, starting, finished_inline, awaiter_suspended };
+
+struct final_awaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <class Promise>
+    void await_suspend(std::coroutine_handle<Promise> h) const noexcept {
+        auto& p = h.promise();
+        if (p.state == await_state::starting) {
+            // Still inside task::await_suspend: it will carry on the awaiter.
+            p.state = await_state::finished_inline;
+        } else if (p.continuation) {
+            // The awaiter may destroy this frame; do not touch `p` afterwards.
+            p.continuation.resume();
+        }
+    }
+
+    void await_resume() const noexcept {}
+};
+
+struct promise_base {
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    final_awaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+    std::coroutine_handle<> continuation;
+    await_state state = await_state::idle;
+    std::exception_ptr exception;
+};
+
+template <class T>
+struct promise : promise_base {
+    task<T> get_return_object() noexcept;
+    void return_value(T v) { value.emplace(std::move(v)); }
+
+    T take() {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+        return std::move(*value);
+    }
+
+    std::optional<T> value;
+};
+
+template <>
+struct promise<void> : promise_base {
+    task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+
+    void take() const {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+}  // namespace detail
+
+template <class T = void>
+class [[nodiscard]] task {
+public:
+    using promise_type = detail::promise<T>;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    explicit task(handle_type h) noexcept : handle_{h} {}
+    task(task&& other) noexcept : handle_{std::exchange(other.handle_, {})} {}
+    task& operator=(task&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    ~task() { reset(); }
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> awaiting) {
+        auto& p = handle_.promise();
+        p.continuation = awaiting;
+        p.state = detail::await_state::starting;
+        handle_.resume();
+        if (p.state == detail::await_state::finished_inline) {
+            return false;
+        }
+        p.state = detail::await_state::awaiter_suspended;
+        return true;
+    }
+
+    T await_resume() { return handle_.promise().take(); }
+
+    handle_type handle() const noexcept { return handle_; }
+
+private:
+    void reset() noexcept {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    handle_type handle_;
+};
+
+namespace detail {
+
+template <class T>
+task<T> promise<T>::get_return_object() noexcept {
+    return task<T>{std::coroutine_handle<promise<T>>::from_promise(*this)};
+}
+
+inline task<void> promise<void>::get_return_object() noexcept {
+    return task<void>{std::coroutine_handle<promise<void>>::from_promise(*this)};
+}
+
+}  // namespace detail
+
+// Runs a task that never waits on anything external (no I/O, no executor) to
+// completion on the calling thread and returns its result.
+template <class T>
+T sync_wait(task<T> t) {
+    t.handle().resume();
+    return t.handle().promise().take();
+}
+
+// Owns itself: created suspended, destroys its frame when it finishes.  Used
+// by executors to run a task<void> without anyone awaiting it.  An exception
+// escaping a detached task terminates, like one escaping a std::thread.
+class detached {
+public:
+    struct promise_type {
+        detached get_return_object() noexcept {
+            return detached{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+
+    std::coroutine_handle<> handle() const noexcept { return handle_; }
+
+private:
+    explicit detached(std::coroutine_handle<> h) noexcept : handle_{h} {}
+
+    std::coroutine_handle<> handle_;
+};
+
+inline detached make_detached(task<void> t) {
+    co_await std::move(t);
+}
+
+}  // namespace coro_io
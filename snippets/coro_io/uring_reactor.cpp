@@ -0,0 +1,159 @@
+#include "uring_reactor.hpp"
+
+#include <linux/io_uring.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+namespace coro_io {
+
+namespace {
+
+template <class T>
+T* at(void* base, std::uint32_t offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+void* map_ring(int fd, std::size_t size, off_t offset) {
+    void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    if (p == MAP_FAILED) {
+        throw std::system_error{errno, std::generic_category(), "mmap io_uring"};
+    }
+    return p;
+}
+
+}  // namespace
+
+uring_reactor::uring_reactor(unsigned entries) {
+    io_uring_params params{};
+    ring_.reset(check(static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params)), "io_uring_setup"));
+
+    sq_map_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_map_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        sq_map_size_ = cq_map_size_ = std::max(sq_map_size_, cq_map_size_);
+    }
+    sq_map_ = map_ring(ring_.get(), sq_map_size_, IORING_OFF_SQ_RING);
+    cq_map_ = (params.features & IORING_FEAT_SINGLE_MMAP)
+                  ? sq_map_
+                  : map_ring(ring_.get(), cq_map_size_, IORING_OFF_CQ_RING);
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(map_ring(ring_.get(), sqes_size_, IORING_OFF_SQES));
+
+    sq_head_ = at<unsigned>(sq_map_, params.sq_off.head);
+    sq_tail_ = at<unsigned>(sq_map_, params.sq_off.tail);
+    sq_array_ = at<unsigned>(sq_map_, params.sq_off.array);
+    sq_mask_ = *at<unsigned>(sq_map_, params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    cq_head_ = at<unsigned>(cq_map_, params.cq_off.head);
+    cq_tail_ = at<unsigned>(cq_map_, params.cq_off.tail);
+    cqes_ = at<io_uring_cqe>(cq_map_, params.cq_off.cqes);
+    cq_mask_ = *at<unsigned>(cq_map_, params.cq_off.ring_mask);
+}
+
+uring_reactor::~uring_reactor() {
+    ::munmap(sqes_, sqes_size_);
+    if (cq_map_ != sq_map_) {
+        ::munmap(cq_map_, cq_map_size_);
+    }
+    ::munmap(sq_map_, sq_map_size_);
+}
+
+uring_reactor::awaiter uring_reactor::accept(int fd) noexcept {
+    return {this, IORING_OP_ACCEPT, fd, nullptr, 0};
+}
+
+uring_reactor::awaiter uring_reactor::recv(int fd, void* buffer, std::size_t length) noexcept {
+    return {this, IORING_OP_RECV, fd, buffer, length};
+}
+
+uring_reactor::awaiter uring_reactor::send(int fd, void const* buffer, std::size_t length) noexcept {
+    return {this, IORING_OP_SEND, fd, const_cast<void*>(buffer), length};
+}
+
+ssize_t uring_reactor::awaiter::await_resume() const noexcept {
+    if (opcode == IORING_OP_ACCEPT && op.result >= 0) {
+        int const on = 1;
+        ::setsockopt(static_cast<int>(op.result), IPPROTO_TCP, TCP_NODELAY, &on, sizeof on);
+    }
+    return op.result;
+}
+
+void uring_reactor::close(int fd) {
+    ::close(fd);
+}
+
+void uring_reactor::submit(operation& op, std::uint8_t opcode, int fd, void* buffer,
+                           std::size_t length) {
+    std::atomic_ref<unsigned> head{*sq_head_};
+    unsigned const tail = *sq_tail_;
+    if (tail - head.load(std::memory_order_acquire) == sq_entries_) {
+        unsubmitted_ -= enter(unsubmitted_, 0);
+    }
+    unsigned const index = tail & sq_mask_;
+    io_uring_sqe& sqe = sqes_[index];
+    std::memset(&sqe, 0, sizeof sqe);
+    sqe.opcode = opcode;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<std::uint64_t>(buffer);
+    sqe.len = static_cast<std::uint32_t>(length);
+    if (opcode == IORING_OP_ACCEPT) {
+        sqe.accept_flags = SOCK_CLOEXEC;
+    } else if (opcode == IORING_OP_SEND) {
+        sqe.msg_flags = MSG_NOSIGNAL;
+    }
+    sqe.user_data = reinterpret_cast<std::uint64_t>(&op);
+    sq_array_[index] = index;
+    std::atomic_ref<unsigned>{*sq_tail_}.store(tail + 1, std::memory_order_release);
+    ++unsubmitted_;
+    ++in_flight_;
+}
+
+unsigned uring_reactor::enter(unsigned to_submit, unsigned min_complete) {
+    for (;;) {
+        long const n = ::syscall(__NR_io_uring_enter, ring_.get(), to_submit, min_complete,
+                                 min_complete ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+        if (n >= 0) {
+            return static_cast<unsigned>(n);
+        }
+        if (errno != EINTR) {
+            check(-1, "io_uring_enter");
+        }
+    }
+}
+
+void uring_reactor::reap() {
+    std::atomic_ref<unsigned> tail_ref{*cq_tail_};
+    unsigned head = *cq_head_;
+    unsigned const tail = tail_ref.load(std::memory_order_acquire);
+    for (; head != tail; ++head) {
+        io_uring_cqe const& cqe = cqes_[head & cq_mask_];
+        auto* op = reinterpret_cast<operation*>(cqe.user_data);
+        op->result = cqe.res;
+        post(op->waiter);
+        --in_flight_;
+    }
+    std::atomic_ref<unsigned>{*cq_head_}.store(head, std::memory_order_release);
+}
+
+void uring_reactor::run() {
+    for (;;) {
+        run_ready();
+        if (in_flight_ == 0) {
+            return;
+        }
+        unsubmitted_ -= enter(unsubmitted_, 1);
+        reap();
+    }
+}
+
+}  // namespace coro_io
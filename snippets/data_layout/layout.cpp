@@ -0,0 +1,74 @@
+// AoS vs SoA vs AoSoA across working-set sizes.
+//
+// The label names the smallest cache level that holds the whole structure, so
+// the curve can be read against L1/L2/L3/DRAM.  With a PMU available the
+// per-iteration cycles, instructions, IPC and cache misses are reported too.
+
+#include "particles.hpp"
+
+#include <cpplearn/bench.hpp>
+#include <cpplearn/perf_counters.hpp>
+
+#include <cmath>
+
+namespace {
+
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+
+constexpr std::int64_t min_particles = 1 << 8;
+constexpr std::int64_t max_particles = 1 << 22;
+
+template <class Layout>
+void bm_update(state& st) {
+    auto const n = static_cast<std::size_t>(st.arg(0));
+    Layout particles{n};
+    cpplearn::bench::perf_counters counters;
+
+    counters.start();
+    for (auto _ : st) {
+        particles.update(1e-3f);
+        cpplearn::bench::clobber_memory();
+    }
+    counters.stop();
+
+    st.set_label(cpplearn::bench::cache_fit(particles.bytes()));
+    counters.report(st);
+    st.set_items_processed(st.iterations() * n);
+    st.set_counter("working_set_bytes", static_cast<double>(particles.bytes()));
+}
+CPPLEARN_BENCHMARK(bm_update<data_layout::aos>)->range(min_particles, max_particles, 4);
+CPPLEARN_BENCHMARK(bm_update<data_layout::soa>)->range(min_particles, max_particles, 4);
+CPPLEARN_BENCHMARK(bm_update<data_layout::aosoa>)->range(min_particles, max_particles, 4);
+
+template <class Layout>
+void bm_filter(state& st) {
+    auto const n = static_cast<std::size_t>(st.arg(0));
+    Layout particles{n};
+
+    // Every layout holds the same particles and visits them in the same order,
+    // so the results must match the AoS reference exactly.
+    auto const expected = data_layout::aos{n}.filter(0.5f);
+    auto const actual = particles.filter(0.5f);
+    if (actual.count != expected.count || actual.mass != expected.mass) {
+        st.error("filter result differs from the AoS reference");
+        return;
+    }
+
+    cpplearn::bench::perf_counters counters;
+    counters.start();
+    for (auto _ : st) {
+        do_not_optimize(particles.filter(0.5f));
+    }
+    counters.stop();
+
+    st.set_label(cpplearn::bench::cache_fit(particles.bytes()));
+    counters.report(st);
+    st.set_items_processed(st.iterations() * n);
+    st.set_counter("working_set_bytes", static_cast<double>(particles.bytes()));
+}
+CPPLEARN_BENCHMARK(bm_filter<data_layout::aos>)->range(min_particles, max_particles, 4);
+CPPLEARN_BENCHMARK(bm_filter<data_layout::soa>)->range(min_particles, max_particles, 4);
+CPPLEARN_BENCHMARK(bm_filter<data_layout::aosoa>)->range(min_particles, max_particles, 4);
+
+}  // namespace
@@ -0,0 +1,195 @@
+// The same particle system in three layouts.
+//
+// A particle has 16 four-byte fields (64 bytes, one cache line): position and
+// velocity are hot, the rest is read rarely.  The kernels touch 6 fields
+// (update) or 2 fields (filter scan), so with an array of structs most of
+// every cache line fetched is wasted, while a struct of arrays streams only
+// the fields in use.  The hybrid AoSoA keeps `lanes` particles' worth of each
+// field together: SIMD-friendly like SoA, but one block per particle group
+// like AoS, which keeps the number of concurrent streams small.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace data_layout {
+
+struct filter_result {
+    std::size_t count = 0;
+    double mass = 0.0;
+};
+
+// Deterministic per-index values so every layout holds identical data.
+struct particle_source {
+    explicit particle_source(std::uint32_t seed) : rng{seed} {}
+
+    float next(float lo, float hi) { return std::uniform_real_distribution<float>{lo, hi}(rng); }
+
+    std::mt19937 rng;
+};
+
+struct particle {
+    float x, y, z;
+    float vx, vy, vz;
+    float mass, charge;
+    std::uint32_t id, flags;
+    float r, g, b, a;
+    float age, lifetime;
+};
+static_assert(sizeof(particle) == 64);
+
+class aos {
+public:
+    static constexpr char const* name = "aos";
+
+    explicit aos(std::size_t n) : p_(n) {
+        particle_source src{1};
+        for (std::size_t i = 0; i < n; ++i) {
+            auto& q = p_[i];
+            q.x = src.next(-1, 1), q.y = src.next(-1, 1), q.z = src.next(-1, 1);
+            q.vx = src.next(-1, 1), q.vy = src.next(-1, 1), q.vz = src.next(-1, 1);
+            q.mass = src.next(0, 1);
+            q.id = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    void update(float dt) noexcept {
+        for (auto& q : p_) {
+            q.x += q.vx * dt;
+            q.y += q.vy * dt;
+            q.z += q.vz * dt;
+        }
+    }
+
+    filter_result filter(float threshold) const noexcept {
+        filter_result result;
+        for (auto const& q : p_) {
+            if (q.x > threshold) {
+                ++result.count;
+                result.mass += q.mass;
+            }
+        }
+        return result;
+    }
+
+    std::size_t bytes() const noexcept { return p_.size() * sizeof(particle); }
+
+private:
+    std::vector<particle> p_;
+};
+
+class soa {
+public:
+    static constexpr char const* name = "soa";
+
+    explicit soa(std::size_t n)
+        : x(n), y(n), z(n), vx(n), vy(n), vz(n), mass(n), charge(n), id(n), flags(n), r(n), g(n), b(n),
+          a(n), age(n), lifetime(n) {
+        particle_source src{1};
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] = src.next(-1, 1), y[i] = src.next(-1, 1), z[i] = src.next(-1, 1);
+            vx[i] = src.next(-1, 1), vy[i] = src.next(-1, 1), vz[i] = src.next(-1, 1);
+            mass[i] = src.next(0, 1);
+            id[i] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    void update(float dt) noexcept {
+        std::size_t const n = x.size();
+        float* __restrict px = x.data();
+        float* __restrict py = y.data();
+        float* __restrict pz = z.data();
+        float const* __restrict pvx = vx.data();
+        float const* __restrict pvy = vy.data();
+        float const* __restrict pvz = vz.data();
+        for (std::size_t i = 0; i < n; ++i) {
+            px[i] += pvx[i] * dt;
+            py[i] += pvy[i] * dt;
+            pz[i] += pvz[i] * dt;
+        }
+    }
+
+    filter_result filter(float threshold) const noexcept {
+        filter_result result;
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            if (x[i] > threshold) {
+                ++result.count;
+                result.mass += mass[i];
+            }
+        }
+        return result;
+    }
+
+    std::size_t bytes() const noexcept { return x.size() * 16 * sizeof(float); }
+
+private:
+    std::vector<float> x, y, z, vx, vy, vz, mass, charge;
+    std::vector<std::uint32_t> id, flags;
+    std::vector<float> r, g, b, a, age, lifetime;
+};
+
+class aosoa {
+public:
+    static constexpr char const* name = "aosoa";
+    static constexpr std::size_t lanes = 8;  // one AVX register of floats
+
+    // n is rounded up to whole blocks; padding lanes have x = -inf so the
+    // filter never selects them.
+    explicit aosoa(std::size_t n) : blocks_((n + lanes - 1) / lanes) {
+        particle_source src{1};
+        for (std::size_t i = 0; i < blocks_.size() * lanes; ++i) {
+            auto& blk = blocks_[i / lanes];
+            std::size_t const l = i % lanes;
+            if (i >= n) {
+                blk.x[l] = -std::numeric_limits<float>::infinity();
+                continue;
+            }
+            blk.x[l] = src.next(-1, 1), blk.y[l] = src.next(-1, 1), blk.z[l] = src.next(-1, 1);
+            blk.vx[l] = src.next(-1, 1), blk.vy[l] = src.next(-1, 1), blk.vz[l] = src.next(-1, 1);
+            blk.mass[l] = src.next(0, 1);
+            blk.id[l] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    void update(float dt) noexcept {
+        for (auto& blk : blocks_) {
+            for (std::size_t l = 0; l < lanes; ++l) {
+                blk.x[l] += blk.vx[l] * dt;
+                blk.y[l] += blk.vy[l] * dt;
+                blk.z[l] += blk.vz[l] * dt;
+            }
+        }
+    }
+
+    filter_result filter(float threshold) const noexcept {
+        filter_result result;
+        for (auto const& blk : blocks_) {
+            for (std::size_t l = 0; l < lanes; ++l) {
+                if (blk.x[l] > threshold) {
+                    ++result.count;
+                    result.mass += blk.mass[l];
+                }
+            }
+        }
+        return result;
+    }
+
+    std::size_t bytes() const noexcept { return blocks_.size() * sizeof(block); }
+
+private:
+    struct block {
+        float x[lanes], y[lanes], z[lanes];
+        float vx[lanes], vy[lanes], vz[lanes];
+        float mass[lanes], charge[lanes];
+        std::uint32_t id[lanes], flags[lanes];
+        float r[lanes], g[lanes], b[lanes], a[lanes];
+        float age[lanes], lifetime[lanes];
+    };
+
+    std::vector<block> blocks_;
+};
+
+}  // namespace data_layout
@@ -0,0 +1,3 @@
+#define ERROR_HANDLING_NAME parse_error_codes
+#define ERROR_HANDLING_LAYER
+#include "error_codes.inl"
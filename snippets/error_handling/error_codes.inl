@@ -0,0 +1,58 @@
+// Failures returned as errc, results written through out parameters.
+// Included by error_codes.cpp and error_codes_noinline.cpp.  Every layer
+// tests and forwards the code, like the expected variant, but the return
+// value is a single byte in a register and the result goes to memory the
+// caller already owns.
+//
+// Expects ERROR_HANDLING_NAME and ERROR_HANDLING_LAYER to be defined.
+
+#include "records.hpp"
+
+namespace error_handling {
+
+namespace {
+
+ERROR_HANDLING_LAYER errc parse_uint(std::string_view text, std::uint32_t& out) {
+    if (text.empty() || text.size() > max_digits) {
+        return errc::bad_number;
+    }
+    std::uint32_t value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return errc::bad_number;
+        }
+        value = value * 10 + static_cast<std::uint32_t>(c - '0');
+    }
+    out = value;
+    return errc::ok;
+}
+
+ERROR_HANDLING_LAYER errc parse_record(std::string_view line, record& out) {
+    if (errc const ec = parse_uint(take_field(line), out.id); ec != errc::ok) {
+        return ec;
+    }
+    if (errc const ec = parse_uint(take_field(line), out.age); ec != errc::ok) {
+        return ec;
+    }
+    if (errc const ec = parse_uint(take_field(line), out.score); ec != errc::ok) {
+        return ec;
+    }
+    return in_range(out) ? errc::ok : errc::out_of_range;
+}
+
+}  // namespace
+
+batch_result ERROR_HANDLING_NAME(std::span<std::string_view const> lines) {
+    batch_result result;
+    for (std::string_view line : lines) {
+        record r;
+        if (parse_record(line, r) == errc::ok) {
+            result.add(r);
+        } else {
+            ++result.failures;
+        }
+    }
+    return result;
+}
+
+}  // namespace error_handling
@@ -0,0 +1,5 @@
+// Same code with every layer kept out of line.  Spelled as an attribute so
+// that the code size measured for compile_stats.inc includes it.
+#define ERROR_HANDLING_NAME parse_error_codes_noinline
+#define ERROR_HANDLING_LAYER [[gnu::noinline]]
+#include "error_codes.inl"
@@ -0,0 +1,82 @@
+// Exceptions vs expected vs error codes on one parse-and-validate workload
+// (records.hpp), from no failures to half the records failing.
+//
+// One iteration parses a batch of 4096 lines, `fail_per_mille` of them
+// broken; items/s counts records.  fail_per_mille:1000 breaks every record,
+// so its time per record is simply the cost of one failure, which the
+// mixed rates cannot pin down: their difference from the clean run is small
+// next to the run-to-run noise.  Every case also reports code_bytes and
+// unwind_bytes for the variant's translation unit, measured at build time
+// (cpplearn/compile_stats.hpp).
+//
+// The `_noinline` variants keep parse_uint and parse_record out of line.
+// Comparing them with the inlined ones shows what each mechanism leaves on
+// the success path once the compiler can no longer fold the layers into the
+// loop: a test and branch per call for expected and error codes, nothing for
+// exceptions.  A throw, on the other hand, allocates the exception object and
+// has the unwinder walk the tables from the throwing frame to the handler, so
+// it costs orders of magnitude more than a returned error.
+
+#include "expected.hpp"
+#include "records.hpp"
+
+#include <cpplearn/bench.hpp>
+#include <cpplearn/compile_stats.hpp>
+
+#include <string>
+#include <string_view>
+
+namespace {
+
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+namespace eh = error_handling;
+
+constexpr std::size_t records = 4096;
+
+constexpr cpplearn::bench::compile_stat compile_stats[] = {
+#include "compile_stats.inc"
+    {},
+};
+
+void bm_parse(state& st, eh::parse_fn parse, std::string_view variant) {
+    auto const fail_per_mille = static_cast<unsigned>(st.arg(0));
+    auto const in = eh::make_input(records, fail_per_mille);
+    auto const expected = eh::parse_error_codes(in.lines);
+    if (parse(in.lines) != expected || expected.failures != in.broken) {
+        st.error("checksum or failure count differs from the reference");
+        return;
+    }
+
+    for (auto _ : st) {
+        do_not_optimize(parse(in.lines));
+    }
+
+    st.set_items_processed(st.iterations() * records);
+    cpplearn::bench::report_code_size(st, compile_stats, variant);
+    if (variant.starts_with("expected")) {
+        st.set_label(eh::std_expected ? "std::expected" : "fallback expected (no C++23 library)");
+    }
+}
+
+[[maybe_unused]] bool const registered = [] {
+    using cpplearn::bench::register_benchmark;
+    struct variant {
+        char const* name;
+        eh::parse_fn parse;
+    };
+    for (auto const& v : {variant{"exceptions", eh::parse_exceptions},
+                          variant{"exceptions_noinline", eh::parse_exceptions_noinline},
+                          variant{"expected", eh::parse_expected},
+                          variant{"expected_noinline", eh::parse_expected_noinline},
+                          variant{"error_codes", eh::parse_error_codes},
+                          variant{"error_codes_noinline", eh::parse_error_codes_noinline}}) {
+        register_benchmark(std::string{"parse/"} + v.name,
+                           [v](state& st) { bm_parse(st, v.parse, v.name); })
+            ->args_product({{0, 1, 10, 100, 500, 1000}})
+            ->arg_names({"fail_per_mille"});
+    }
+    return true;
+}();
+
+}  // namespace
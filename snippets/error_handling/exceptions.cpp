@@ -0,0 +1,3 @@
+#define ERROR_HANDLING_NAME parse_exceptions
+#define ERROR_HANDLING_LAYER
+#include "exceptions.inl"
@@ -0,0 +1,54 @@
+// Failures thrown as parse_error and caught in the batch loop.  Included by
+// exceptions.cpp and exceptions_noinline.cpp.  The layers carry no error
+// handling at all: GCC moves the throw paths to .text.unlikely and the
+// unwinder finds the handler through .eh_frame and .gcc_except_table, which
+// is where this variant pays in size rather than in instructions.
+//
+// Expects ERROR_HANDLING_NAME and ERROR_HANDLING_LAYER to be defined.
+
+#include "records.hpp"
+
+namespace error_handling {
+
+namespace {
+
+ERROR_HANDLING_LAYER std::uint32_t parse_uint(std::string_view text) {
+    if (text.empty() || text.size() > max_digits) {
+        throw parse_error{errc::bad_number};
+    }
+    std::uint32_t value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            throw parse_error{errc::bad_number};
+        }
+        value = value * 10 + static_cast<std::uint32_t>(c - '0');
+    }
+    return value;
+}
+
+ERROR_HANDLING_LAYER record parse_record(std::string_view line) {
+    record r;
+    r.id = parse_uint(take_field(line));
+    r.age = parse_uint(take_field(line));
+    r.score = parse_uint(take_field(line));
+    if (!in_range(r)) {
+        throw parse_error{errc::out_of_range};
+    }
+    return r;
+}
+
+}  // namespace
+
+batch_result ERROR_HANDLING_NAME(std::span<std::string_view const> lines) {
+    batch_result result;
+    for (std::string_view line : lines) {
+        try {
+            result.add(parse_record(line));
+        } catch (parse_error const&) {
+            ++result.failures;
+        }
+    }
+    return result;
+}
+
+}  // namespace error_handling
@@ -0,0 +1,3 @@
+#define ERROR_HANDLING_NAME parse_expected
+#define ERROR_HANDLING_LAYER
+#include "expected.inl"
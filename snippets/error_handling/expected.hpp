@@ -0,0 +1,90 @@
+// error_handling::expected: std::expected where the library has it (C++23),
+// otherwise a minimal stand-in with the same layout, a value or an error in
+// a union plus a flag, and the subset of the interface the snippets use.
+#pragma once
+
+#include <version>
+
+#if defined(__cpp_lib_expected)
+
+#include <expected>
+
+namespace error_handling {
+
+using std::expected;
+using std::unexpected;
+
+inline constexpr bool std_expected = true;
+
+}  // namespace error_handling
+
+#else
+
+#include <memory>
+#include <utility>
+
+namespace error_handling {
+
+inline constexpr bool std_expected = false;
+
+template <class E>
+class unexpected {
+public:
+    constexpr explicit unexpected(E e) : error_{std::move(e)} {}
+    constexpr E const& error() const noexcept { return error_; }
+
+private:
+    E error_;
+};
+
+template <class T, class E>
+class expected {
+public:
+    constexpr expected(T value) : value_{std::move(value)}, has_value_{true} {}  // implicit, like std::expected
+    constexpr expected(unexpected<E> e) : error_{e.error()}, has_value_{false} {}
+
+    constexpr expected(expected const& other) : has_value_{other.has_value_} {
+        if (has_value_) {
+            std::construct_at(&value_, other.value_);
+        } else {
+            std::construct_at(&error_, other.error_);
+        }
+    }
+
+    constexpr expected(expected&& other) noexcept : has_value_{other.has_value_} {
+        if (has_value_) {
+            std::construct_at(&value_, std::move(other.value_));
+        } else {
+            std::construct_at(&error_, std::move(other.error_));
+        }
+    }
+
+    expected& operator=(expected const&) = delete;
+    expected& operator=(expected&&) = delete;
+
+    constexpr ~expected() {
+        if (has_value_) {
+            std::destroy_at(&value_);
+        } else {
+            std::destroy_at(&error_);
+        }
+    }
+
+    constexpr bool has_value() const noexcept { return has_value_; }
+    constexpr explicit operator bool() const noexcept { return has_value_; }
+
+    constexpr T const& operator*() const noexcept { return value_; }
+    constexpr T const* operator->() const noexcept { return &value_; }
+    constexpr E const& error() const noexcept { return error_; }
+
+private:
+    union {
+        T value_;
+        E error_;
+    };
+    bool has_value_;
+};
+
+}  // namespace error_handling
+
+#endif
@@ -0,0 +1,65 @@
+// Failures returned as expected<T, errc> and forwarded by every layer.
+// Included by expected.cpp and expected_noinline.cpp.  Each layer tests the
+// result of the one below and rebuilds the error for its own return type; the
+// value and the flag travel together, in registers when they fit (the
+// 4-byte parse_uint result does, the 16-byte record result goes through
+// memory).
+//
+// Expects ERROR_HANDLING_NAME and ERROR_HANDLING_LAYER to be defined.
+
+#include "expected.hpp"
+#include "records.hpp"
+
+namespace error_handling {
+
+namespace {
+
+ERROR_HANDLING_LAYER expected<std::uint32_t, errc> parse_uint(std::string_view text) {
+    if (text.empty() || text.size() > max_digits) {
+        return unexpected{errc::bad_number};
+    }
+    std::uint32_t value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') {
+            return unexpected{errc::bad_number};
+        }
+        value = value * 10 + static_cast<std::uint32_t>(c - '0');
+    }
+    return value;
+}
+
+ERROR_HANDLING_LAYER expected<record, errc> parse_record(std::string_view line) {
+    auto const id = parse_uint(take_field(line));
+    if (!id) {
+        return unexpected{id.error()};
+    }
+    auto const age = parse_uint(take_field(line));
+    if (!age) {
+        return unexpected{age.error()};
+    }
+    auto const score = parse_uint(take_field(line));
+    if (!score) {
+        return unexpected{score.error()};
+    }
+    record const r{*id, *age, *score};
+    if (!in_range(r)) {
+        return unexpected{errc::out_of_range};
+    }
+    return r;
+}
+
+}  // namespace
+
+batch_result ERROR_HANDLING_NAME(std::span<std::string_view const> lines) {
+    batch_result result;
+    for (std::string_view line : lines) {
+        if (auto const r = parse_record(line)) {
+            result.add(*r);
+        } else {
+            ++result.failures;
+        }
+    }
+    return result;
+}
+
+}  // namespace error_handling
@@ -0,0 +1,35 @@
+#include "records.hpp"
+
+#include <random>
+
+namespace error_handling {
+
+input make_input(std::size_t records, unsigned fail_per_mille) {
+    std::mt19937 rng{11};
+    std::uniform_int_distribution<std::uint32_t> id{1, 999'999'999};
+    std::uniform_int_distribution<std::uint32_t> age{0, 150};
+    std::uniform_int_distribution<std::uint32_t> score{0, 1000};
+    std::uniform_int_distribution<unsigned> per_mille{0, 999};
+
+    input in;
+    std::vector<std::size_t> ends;
+    for (std::size_t i = 0; i < records; ++i) {
+        bool const broken = per_mille(rng) < fail_per_mille;
+        in.broken += broken;
+        std::uint32_t const a = broken && i % 2 != 0 ? 151 + age(rng) : age(rng);
+        in.text += std::to_string(id(rng)) + ',' + std::to_string(a) + ',' + std::to_string(score(rng));
+        if (broken && i % 2 == 0) {
+            in.text.back() = 'x';
+        }
+        ends.push_back(in.text.size());
+        in.text += '\n';
+    }
+    std::size_t start = 0;
+    for (std::size_t end : ends) {
+        in.lines.emplace_back(in.text.data() + start, end - start);
+        start = end + 1;
+    }
+    return in;
+}
+
+}  // namespace error_handling
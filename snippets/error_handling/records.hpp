@@ -0,0 +1,95 @@
+// The parse-and-validate workload every error-handling variant runs.
+//
+// A record is one line of three unsigned decimal fields, `id,age,score`.
+// Parsing fails on an empty field, a non-digit or more than nine digits;
+// validation fails on age > 150 or score > 1000.  A batch parses every line,
+// sums a checksum over the valid records and counts the failures.
+//
+// The variants differ only in how a failure travels from where it is found
+// (parse_uint, two calls down, or the range check) to the batch loop:
+//
+//   exceptions   throw parse_error, caught once per record
+//   expected     every layer returns expected<T, errc> and forwards errors
+//   error_codes  every layer returns errc and writes its result through an
+//                out parameter
+//
+// Each comes from its own translation unit, twice: as written, free to inline
+// the layers into the batch loop, and with every layer [[gnu::noinline]], as
+// if it lived in another library.
+#pragma once
+
+#include <cstdint>
+#include <exception>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace error_handling {
+
+enum class errc : std::uint8_t { ok, bad_number, out_of_range };
+
+struct record {
+    std::uint32_t id;
+    std::uint32_t age;
+    std::uint32_t score;
+};
+
+struct batch_result {
+    std::uint64_t checksum = 0;
+    std::uint64_t failures = 0;
+
+    void add(record const& r) noexcept { checksum += r.id + 7u * r.age + 13u * r.score; }
+
+    friend bool operator==(batch_result const&, batch_result const&) = default;
+};
+
+// Thrown by the exception variants.  Carries a code rather than a formatted
+// message, so a throw costs the exception machinery and not a string.
+class parse_error : public std::exception {
+public:
+    explicit parse_error(errc code) noexcept : code_{code} {}
+
+    errc code() const noexcept { return code_; }
+    char const* what() const noexcept override {
+        return code_ == errc::bad_number ? "malformed number" : "value out of range";
+    }
+
+private:
+    errc code_;
+};
+
+inline constexpr std::size_t max_digits = 9;  // so the value fits in 32 bits
+
+// The text up to the next ',' (or the end); `line` advances past it.
+inline std::string_view take_field(std::string_view& line) noexcept {
+    std::size_t const comma = line.find(',');
+    std::string_view const field = line.substr(0, comma);
+    line.remove_prefix(comma == std::string_view::npos ? line.size() : comma + 1);
+    return field;
+}
+
+inline bool in_range(record const& r) noexcept {
+    return r.age <= 150 && r.score <= 1000;
+}
+
+// Lines pointing into `text`.  `fail_per_mille` of them, spread at random,
+// are broken: half with a letter in the score field, half with an age out of
+// range.  Deterministic for given arguments.
+struct input {
+    std::string text;
+    std::vector<std::string_view> lines;
+    std::uint64_t broken = 0;
+};
+input make_input(std::size_t records, unsigned fail_per_mille);
+
+using parse_fn = batch_result (*)(std::span<std::string_view const>);
+
+batch_result parse_exceptions(std::span<std::string_view const> lines);            // exceptions.cpp
+batch_result parse_exceptions_noinline(std::span<std::string_view const> lines);   // exceptions_noinline.cpp
+batch_result parse_expected(std::span<std::string_view const> lines);              // expected.cpp
+batch_result parse_expected_noinline(std::span<std::string_view const> lines);     // expected_noinline.cpp
+batch_result parse_error_codes(std::span<std::string_view const> lines);           // error_codes.cpp
+batch_result parse_error_codes_noinline(std::span<std::string_view const> lines);  // error_codes_noinline.cpp
+
+}  // namespace error_handling
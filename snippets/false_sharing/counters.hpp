@@ -0,0 +1,157 @@
+// Counters that several threads bump at once, from the one that scales worst
+// to the ones that scale.
+//
+// shared_counter        one atomic, fetch_add from every thread: true sharing,
+//                       the cache line holding it moves on every increment
+// slot_array<Align>     one single-writer slot per thread, each aligned to
+//                       `Align` bytes.  With Align = 8 the slots are packed
+//                       eight to a cache line and the threads still fight
+//                       over lines they never logically share (false
+//                       sharing); with the destructive interference size each
+//                       slot has a line of its own
+// sharded_counter       each thread keeps its shard in memory it owns (its
+//                       stack, here) and registers it with the counter;
+//                       readers sum the live shards and what finished threads
+//                       left behind
+// batched_counter       one shared atomic again, but each thread counts into
+//                       a plain local and flushes every `batch` increments, so
+//                       the line moves once per batch
+//
+// Single-writer slots and shards are updated with a relaxed load and store,
+// not a read-modify-write: only their owner writes them, and readers only
+// need a value that is not torn.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace false_sharing {
+
+class shared_counter {
+public:
+    void add(std::uint64_t n) noexcept { value_.fetch_add(n, std::memory_order_relaxed); }
+    std::uint64_t read() const noexcept { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> value_{0};
+};
+
+template <std::size_t Align>
+struct alignas(Align) slot {
+    std::atomic<std::uint64_t> value{0};
+
+    void add(std::uint64_t n) noexcept {
+        value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+};
+
+template <std::size_t Align>
+class slot_array {
+public:
+    static constexpr std::size_t stride = sizeof(slot<Align>);
+
+    explicit slot_array(std::size_t threads) : slots_(threads) {}
+
+    void add(std::size_t thread, std::uint64_t n) noexcept { slots_[thread].add(n); }
+
+    std::uint64_t read() const noexcept {
+        std::uint64_t sum = 0;
+        for (auto const& s : slots_) {
+            sum += s.value.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+private:
+    std::vector<slot<Align>> slots_;
+};
+
+class sharded_counter {
+public:
+    // One thread's share of the count.  Create it on the thread that adds to
+    // it; on destruction its value moves into the counter.
+    class shard {
+    public:
+        explicit shard(sharded_counter& counter) : counter_{counter} { counter_.attach(this); }
+        ~shard() { counter_.detach(this); }
+
+        shard(shard const&) = delete;
+        shard& operator=(shard const&) = delete;
+
+        void add(std::uint64_t n) noexcept {
+            value_.store(value_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+    private:
+        friend class sharded_counter;
+        sharded_counter& counter_;
+        std::atomic<std::uint64_t> value_{0};
+    };
+
+    std::uint64_t read() const {
+        std::lock_guard lock{mutex_};
+        std::uint64_t sum = retired_;
+        for (shard const* s : shards_) {
+            sum += s->value_.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+private:
+    void attach(shard* s) {
+        std::lock_guard lock{mutex_};
+        shards_.push_back(s);
+    }
+
+    void detach(shard* s) {
+        std::lock_guard lock{mutex_};
+        retired_ += s->value_.load(std::memory_order_relaxed);
+        std::erase(shards_, s);
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<shard*> shards_;
+    std::uint64_t retired_ = 0;
+};
+
+class batched_counter {
+public:
+    // Counts locally and flushes into the shared total every `batch`
+    // increments and on destruction.  Readers see the total up to one
+    // unflushed batch per thread behind.
+    class local {
+    public:
+        local(batched_counter& counter, std::uint64_t batch) : counter_{counter}, batch_{batch} {}
+        ~local() { flush(); }
+
+        local(local const&) = delete;
+        local& operator=(local const&) = delete;
+
+        void add(std::uint64_t n) noexcept {
+            pending_ += n;
+            if (pending_ >= batch_) {
+                flush();
+            }
+        }
+
+        void flush() noexcept {
+            counter_.total_.fetch_add(pending_, std::memory_order_relaxed);
+            pending_ = 0;
+        }
+
+    private:
+        batched_counter& counter_;
+        std::uint64_t batch_;
+        std::uint64_t pending_ = 0;
+    };
+
+    std::uint64_t read() const noexcept { return total_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> total_{0};
+};
+
+}  // namespace false_sharing
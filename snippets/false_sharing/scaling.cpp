@@ -0,0 +1,145 @@
+// Per-thread counting from 1 to all CPUs: the shared atomic, the packed
+// per-thread slots that false-share, and three ways out (counters.hpp).
+//
+// One iteration is one increment on each of `threads` threads, so perfect
+// scaling keeps ns/op flat while items/s grows with the thread count.
+// `scaling` is the total increments per second relative to the same counter's
+// `threads:1` case (so keep that case when filtering): `threads` is ideal, 1
+// means the extra cores bought nothing, below 1 they made it slower.  Sweep with
+// --format=csv to plot it.  On one CPU only `threads:1` exists and nothing
+// can be shared; the contrast needs a multi-core machine, and is largest
+// when the threads sit on different sockets.
+//
+// `padded` aligns each slot to std::hardware_destructive_interference_size
+// (64 on x86-64 with GCC).  Some Intel cores prefetch cache lines in pairs,
+// so two threads on adjacent 64-byte lines can still interfere a little;
+// padding to 128 bytes removes that at twice the memory.
+//
+// Every run checks that no increment was lost.
+
+#include "counters.hpp"
+
+#include <cpplearn/bench.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <new>
+
+namespace {
+
+using cpplearn::bench::state;
+namespace fs = false_sharing;
+
+// Used here rather than in counters.hpp: GCC warns about the constant in
+// headers, where it could leak into an ABI.
+constexpr std::size_t line = std::hardware_destructive_interference_size;
+
+struct shared {
+    static constexpr bool takes_batch = false;
+    fs::shared_counter counter;
+
+    shared(unsigned, std::uint64_t) {}
+    void run(unsigned, std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            counter.add(1);
+        }
+    }
+    std::uint64_t read() const { return counter.read(); }
+};
+
+template <std::size_t Align>
+struct slots {
+    static constexpr bool takes_batch = false;
+    static constexpr std::size_t stride = fs::slot_array<Align>::stride;
+    fs::slot_array<Align> counter;
+
+    slots(unsigned threads, std::uint64_t) : counter{threads} {}
+    void run(unsigned thread, std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            counter.add(thread, 1);
+        }
+    }
+    std::uint64_t read() const { return counter.read(); }
+};
+
+using packed = slots<alignof(std::atomic<std::uint64_t>)>;
+using padded = slots<line>;
+
+struct sharded {
+    static constexpr bool takes_batch = false;
+    fs::sharded_counter counter;
+
+    sharded(unsigned, std::uint64_t) {}
+    void run(unsigned, std::uint64_t iterations) {
+        fs::sharded_counter::shard mine{counter};
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            mine.add(1);
+        }
+    }
+    std::uint64_t read() const { return counter.read(); }
+};
+
+struct batched {
+    static constexpr bool takes_batch = true;
+    fs::batched_counter counter;
+    std::uint64_t batch;
+
+    batched(unsigned, std::uint64_t b) : batch{b} {}
+    void run(unsigned, std::uint64_t iterations) {
+        fs::batched_counter::local mine{counter, batch};
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            mine.add(1);
+        }
+    }
+    std::uint64_t read() const { return counter.read(); }
+};
+
+// The best rate the `threads:1` case of `Counter` reached, per batch size:
+// the one-thread baseline, measured through exactly the code the threaded
+// runs use.  0 until that case has run.
+template <class Counter>
+double& one_thread_rate(std::uint64_t batch) {
+    static std::map<std::uint64_t, double> rates;
+    return rates[batch];
+}
+
+template <class Counter>
+void bm_count(state& st) {
+    auto const threads = static_cast<unsigned>(st.arg(0));
+    std::uint64_t const batch = Counter::takes_batch ? static_cast<std::uint64_t>(st.arg(1)) : 0;
+    Counter c{threads, batch};
+    st.run_threads(threads, [&c](unsigned thread, std::uint64_t iterations) { c.run(thread, iterations); });
+    std::uint64_t const total = st.iterations() * threads;
+    if (c.read() != total) {
+        st.error("increments were lost");
+        return;
+    }
+    st.set_items_processed(total);
+    double const rate = static_cast<double>(total) / st.elapsed_seconds();
+    double& one = one_thread_rate<Counter>(batch);
+    if (threads == 1) {
+        one = std::max(one, rate);
+    }
+    if (one > 0.0) {
+        st.set_counter("scaling", rate / one);
+    }
+    if constexpr (requires { Counter::stride; }) {
+        st.set_counter("slot_bytes", static_cast<double>(Counter::stride));
+    }
+}
+
+[[maybe_unused]] bool const registered = [] {
+    using cpplearn::bench::register_benchmark;
+    auto const threads = cpplearn::bench::thread_counts();
+    register_benchmark("count/shared", bm_count<shared>)->args_product({threads})->arg_names({"threads"});
+    register_benchmark("count/packed", bm_count<packed>)->args_product({threads})->arg_names({"threads"});
+    register_benchmark("count/padded", bm_count<padded>)->args_product({threads})->arg_names({"threads"});
+    register_benchmark("count/sharded", bm_count<sharded>)->args_product({threads})->arg_names({"threads"});
+    register_benchmark("count/batched", bm_count<batched>)
+        ->args_product({threads, {16, 256, 4096}})
+        ->arg_names({"threads", "batch"});
+    return true;
+}();
+
+}  // namespace
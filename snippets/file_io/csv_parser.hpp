@@ -0,0 +1,82 @@
+// A streaming parser for the generated access log, working on string_views
+// into the caller's buffer.
+//
+// Each line is `timestamp,level,service,latency_us,message`.  The parser keeps
+// only running totals (rows, ERROR rows, summed latency), so every reader can
+// be checked against the totals recorded when the file was written.  It never
+// copies: fields are string_views into whatever memory the reader handed in,
+// be it a read() buffer or a file mapping.
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace file_io {
+
+struct log_totals {
+    std::uint64_t rows = 0;
+    std::uint64_t errors = 0;
+    std::uint64_t latency_us = 0;
+
+    friend bool operator==(log_totals const&, log_totals const&) = default;
+};
+
+class csv_parser {
+public:
+    // Parses every complete line in `chunk` and returns the number of bytes
+    // consumed, i.e. up to and including the last '\n'.  The caller keeps the
+    // rest and passes it again at the front of the next chunk.
+    std::size_t feed(std::string_view chunk) {
+        char const* const begin = chunk.data();
+        char const* const end = begin + chunk.size();
+        char const* line = begin;
+        while (line < end) {
+            auto const* nl = static_cast<char const*>(std::memchr(line, '\n', static_cast<std::size_t>(end - line)));
+            if (nl == nullptr) {
+                break;
+            }
+            parse_line({line, static_cast<std::size_t>(nl - line)});
+            line = nl + 1;
+        }
+        return static_cast<std::size_t>(line - begin);
+    }
+
+    // The final line of a file that does not end in '\n'.
+    void finish(std::string_view tail) {
+        if (!tail.empty()) {
+            parse_line(tail);
+        }
+    }
+
+    log_totals const& totals() const noexcept { return totals_; }
+
+    // One line, already split off; also used by the copying baseline.
+    void parse_line(std::string_view line) {
+        std::string_view fields[5];
+        std::size_t count = 0;
+        while (count < 4) {
+            std::size_t const comma = line.find(',');
+            if (comma == std::string_view::npos) {
+                break;
+            }
+            fields[count++] = line.substr(0, comma);
+            line.remove_prefix(comma + 1);
+        }
+        fields[count++] = line;
+        if (count < 5) {
+            return;
+        }
+        ++totals_.rows;
+        totals_.errors += fields[1] == "ERROR";
+        std::uint64_t latency = 0;
+        std::from_chars(fields[3].data(), fields[3].data() + fields[3].size(), latency);
+        totals_.latency_us += latency;
+    }
+
+private:
+    log_totals totals_;
+};
+
+}  // namespace file_io
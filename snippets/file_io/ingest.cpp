@@ -0,0 +1,202 @@
+// Reading a generated CSV log and parsing every line, several ways.
+//
+// getline_copy:     std::ifstream + std::getline into a std::string, fields
+//                   split into std::strings.  What most code does first.
+// ifstream_read:    std::ifstream::read into one reused buffer, string_view
+//                   parsing.
+// read/buf:N:       ::read into one reused N-byte buffer, string_view parsing.
+//                   The kernel copies into the buffer; nothing else is copied
+//                   except the partial line carried over between chunks.
+// mmap[+advice]:    the file mapped read-only and parsed in place as one
+//                   string_view: no copy at all, but every page is faulted
+//                   in and stays resident until the mapping goes.  Advice:
+//                   MADV_SEQUENTIAL (aggressive readahead), MADV_WILLNEED
+//                   plus MADV_SEQUENTIAL (start reading everything now) or
+//                   MAP_POPULATE (fault it all in up front).
+//
+// mb is the file size, cold:1 drops the file from the page cache before every
+// iteration (outside the timed region), so reads come from the device.
+// peak_rss_mb is the process's peak RSS during the run and rss_growth_mb how
+// far above the starting RSS that peak was; the reused read buffers are
+// allocated before the window starts, so they count in the first only.
+// Every run is checked against the row, ERROR and latency totals recorded
+// when the file was generated.
+
+#include "csv_parser.hpp"
+#include "log_file.hpp"
+#include "rss.hpp"
+
+#include <cpplearn/bench.hpp>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::state;
+using file_io::csv_parser;
+using file_io::log_file;
+using file_io::log_totals;
+
+constexpr double megabyte = 1024.0 * 1024.0;
+
+void run_ingest(state& st, std::function<log_totals(log_file const&)> const& read_file) {
+    auto const& file = file_io::generated_log(static_cast<std::size_t>(st.arg(0)));
+    bool const cold = st.arg(1) != 0;
+    if (cold) {
+        file_io::drop_from_page_cache(file);
+        if (file_io::resident_fraction(file) > 0.5) {
+            st.skip("page cache cannot be dropped for " + file.path + " (tmpfs?)");
+            return;
+        }
+    }
+
+    bool const rss_window = file_io::reset_peak_rss();
+    auto const rss_start = file_io::current_rss();
+    log_totals result;
+    for (auto _ : st) {
+        if (cold) {
+            st.pause_timing();
+            file_io::drop_from_page_cache(file);
+            st.resume_timing();
+        }
+        result = read_file(file);
+    }
+
+    if (result != file.expected) {
+        st.error("parsed totals differ from the generated file");
+    }
+    st.set_bytes_processed(file.bytes * st.iterations());
+    auto const rss_peak = file_io::peak_rss();
+    if (rss_window && rss_start && rss_peak) {
+        st.set_counter("peak_rss_mb", static_cast<double>(*rss_peak) / megabyte);
+        st.set_counter("rss_growth_mb", static_cast<double>(*rss_peak - *rss_start) / megabyte);
+    }
+}
+
+// Feeds chunks from `read(dst, max)` (0 at end of file) through the parser,
+// carrying each chunk's incomplete last line to the front of the buffer.
+template <class Read>
+log_totals parse_chunks(std::vector<char>& buffer, Read read) {
+    csv_parser parser;
+    std::size_t carry = 0;
+    for (;;) {
+        std::size_t const n = read(buffer.data() + carry, buffer.size() - carry);
+        if (n == 0) {
+            break;
+        }
+        std::size_t const filled = carry + n;
+        std::size_t const used = parser.feed({buffer.data(), filled});
+        carry = filled - used;
+        if (carry == buffer.size()) {
+            throw std::runtime_error{"line longer than the read buffer"};
+        }
+        std::memmove(buffer.data(), buffer.data() + used, carry);
+    }
+    parser.finish({buffer.data(), carry});
+    return parser.totals();
+}
+
+void bm_getline_copy(state& st) {
+    run_ingest(st, [](log_file const& file) {
+        std::ifstream in{file.path, std::ios::binary};
+        std::string line;
+        std::vector<std::string> fields;
+        log_totals totals;
+        while (std::getline(in, line)) {
+            fields.clear();
+            std::size_t start = 0;
+            for (std::size_t comma; fields.size() < 4 && (comma = line.find(',', start)) != std::string::npos;
+                 start = comma + 1) {
+                fields.push_back(line.substr(start, comma - start));
+            }
+            fields.push_back(line.substr(start));
+            if (fields.size() < 5) {
+                continue;
+            }
+            ++totals.rows;
+            totals.errors += fields[1] == "ERROR";
+            totals.latency_us += std::stoull(fields[3]);
+        }
+        return totals;
+    });
+}
+CPPLEARN_BENCHMARK_NAMED("getline_copy", bm_getline_copy)
+    ->args_product({{64, 256}, {0, 1}})
+    ->arg_names({"mb", "cold"});
+
+void bm_ifstream_read(state& st) {
+    std::vector<char> buffer(256 << 10);
+    run_ingest(st, [&](log_file const& file) {
+        std::ifstream in{file.path, std::ios::binary};
+        return parse_chunks(buffer, [&](char* dst, std::size_t max) {
+            in.read(dst, static_cast<std::streamsize>(max));
+            return static_cast<std::size_t>(in.gcount());
+        });
+    });
+}
+CPPLEARN_BENCHMARK_NAMED("ifstream_read", bm_ifstream_read)
+    ->args_product({{64, 256}, {0, 1}})
+    ->arg_names({"mb", "cold"});
+
+void bm_read(state& st, std::size_t buffer_size) {
+    std::vector<char> buffer(buffer_size);
+    run_ingest(st, [&](log_file const& file) {
+        auto fd = file_io::open_read_only(file.path);
+        return parse_chunks(buffer, [&](char* dst, std::size_t max) {
+            ssize_t const n = ::read(fd.get(), dst, max);
+            if (n < 0) {
+                throw std::runtime_error{"read failed"};
+            }
+            return static_cast<std::size_t>(n);
+        });
+    });
+}
+
+void bm_mmap(state& st, int advice, int flags) {
+    run_ingest(st, [=](log_file const& file) {
+        auto fd = file_io::open_read_only(file.path);
+        void* map = ::mmap(nullptr, file.bytes, PROT_READ, MAP_PRIVATE | flags, fd.get(), 0);
+        if (map == MAP_FAILED) {
+            throw std::runtime_error{"mmap failed"};
+        }
+        if (advice == MADV_WILLNEED) {
+            ::madvise(map, file.bytes, MADV_SEQUENTIAL);
+        }
+        if (advice != MADV_NORMAL) {
+            ::madvise(map, file.bytes, advice);
+        }
+        std::string_view const all{static_cast<char const*>(map), file.bytes};
+        csv_parser parser;
+        parser.finish(all.substr(parser.feed(all)));
+        ::munmap(map, file.bytes);
+        return parser.totals();
+    });
+}
+
+[[maybe_unused]] bool const registered = [] {
+    auto add = [](std::string name, std::function<void(state&)> fn) {
+        cpplearn::bench::register_benchmark(std::move(name), std::move(fn))
+            ->args_product({{64, 256}, {0, 1}})
+            ->arg_names({"mb", "cold"});
+    };
+    for (std::size_t kb : {16, 256, 4096}) {
+        add("read/buf:" + std::to_string(kb) + "K", [kb](state& st) { bm_read(st, kb << 10); });
+    }
+    add("mmap", [](state& st) { bm_mmap(st, MADV_NORMAL, 0); });
+    add("mmap+sequential", [](state& st) { bm_mmap(st, MADV_SEQUENTIAL, 0); });
+    add("mmap+willneed", [](state& st) { bm_mmap(st, MADV_WILLNEED, 0); });
+    add("mmap+populate", [](state& st) { bm_mmap(st, MADV_NORMAL, MAP_POPULATE); });
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,144 @@
+#include "log_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace file_io {
+
+namespace {
+
+[[noreturn]] void throw_errno(char const* what) {
+    throw std::system_error{errno, std::generic_category(), what};
+}
+
+// Removes the generated files when the program exits.
+struct log_registry {
+    std::map<std::size_t, log_file> files;
+
+    ~log_registry() {
+        for (auto const& [size, file] : files) {
+            std::error_code ignored;
+            std::filesystem::remove(file.path, ignored);
+        }
+    }
+};
+
+log_file generate(std::size_t megabytes) {
+    static constexpr std::string_view levels[] = {"INFO", "INFO", "INFO", "INFO", "DEBUG", "WARN", "ERROR"};
+    static constexpr std::string_view services[] = {"auth", "billing", "catalog", "checkout", "search"};
+    static constexpr std::string_view words[] = {"GET", "POST", "/api/v1/items", "/api/v1/users", "timeout",
+                                                 "retry", "ok", "cache-miss", "upstream", "tenant=42"};
+
+    log_file file;
+    file.path = (std::filesystem::temp_directory_path() /
+                 ("cpplearn_file_io_" + std::to_string(::getpid()) + "_" + std::to_string(megabytes) + ".csv"))
+                    .string();
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> out{std::fopen(file.path.c_str(), "wb"), std::fclose};
+    if (!out) {
+        throw_errno("fopen");
+    }
+
+    std::size_t const target = megabytes << 20;
+    std::uint64_t rng = 0x9e3779b97f4a7c15;
+    auto next = [&rng] {
+        rng ^= rng << 13, rng ^= rng >> 7, rng ^= rng << 17;
+        return rng;
+    };
+    std::string line;
+    char number[24];
+    for (std::uint64_t ts = 1'700'000'000'000; file.bytes < target; ts += next() % 50) {
+        auto const level = levels[next() % std::size(levels)];
+        std::uint64_t const latency = next() % 100'000;
+
+        line.clear();
+        line.append(number, std::to_chars(number, number + sizeof number, ts).ptr);
+        line += ',';
+        line += level;
+        line += ',';
+        line += services[next() % std::size(services)];
+        line += ',';
+        line.append(number, std::to_chars(number, number + sizeof number, latency).ptr);
+        line += ',';
+        for (std::uint64_t w = 2 + next() % 8; w > 0; --w) {
+            line += words[next() % std::size(words)];
+            line += w > 1 ? ' ' : '\n';
+        }
+        if (std::fwrite(line.data(), 1, line.size(), out.get()) != line.size()) {
+            throw_errno("fwrite");
+        }
+        file.bytes += line.size();
+        ++file.expected.rows;
+        file.expected.errors += level == "ERROR";
+        file.expected.latency_us += latency;
+    }
+    // Written pages must reach the disk before they can be evicted.
+    if (std::fflush(out.get()) != 0 || ::fsync(::fileno(out.get())) != 0) {
+        throw_errno("fsync");
+    }
+    return file;
+}
+
+}  // namespace
+
+fd_guard::~fd_guard() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+fd_guard open_read_only(std::string const& path) {
+    int const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw_errno("open");
+    }
+    return fd_guard{fd};
+}
+
+log_file const& generated_log(std::size_t megabytes) {
+    static log_registry registry;
+    auto it = registry.files.find(megabytes);
+    if (it == registry.files.end()) {
+        it = registry.files.emplace(megabytes, generate(megabytes)).first;
+    }
+    return it->second;
+}
+
+void drop_from_page_cache(log_file const& file) {
+    fd_guard fd = open_read_only(file.path);
+    ::posix_fadvise(fd.get(), 0, 0, POSIX_FADV_DONTNEED);
+}
+
+double resident_fraction(log_file const& file) {
+    fd_guard fd = open_read_only(file.path);
+
+    void* map = ::mmap(nullptr, file.bytes, PROT_READ, MAP_SHARED, fd.get(), 0);
+    if (map == MAP_FAILED) {
+        throw_errno("mmap");
+    }
+    long const page = ::sysconf(_SC_PAGESIZE);
+    std::vector<unsigned char> resident((file.bytes + static_cast<std::size_t>(page) - 1) / static_cast<std::size_t>(page));
+    int const rc = ::mincore(map, file.bytes, resident.data());
+    ::munmap(map, file.bytes);
+    if (rc != 0) {
+        throw_errno("mincore");
+    }
+    std::size_t in_cache = 0;
+    for (unsigned char r : resident) {
+        in_cache += r & 1;
+    }
+    return static_cast<double>(in_cache) / static_cast<double>(resident.size());
+}
+
+}  // namespace file_io
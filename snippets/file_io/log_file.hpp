@@ -0,0 +1,46 @@
+// The generated input: a CSV access log of a given size in the temp directory
+// (TMPDIR, else /tmp), written once per size and removed at exit.  Point
+// TMPDIR at the disk you care about; a tmpfs directory cannot be read cold.
+#pragma once
+
+#include "csv_parser.hpp"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace file_io {
+
+// Closes a POSIX file descriptor on scope exit.
+class fd_guard {
+public:
+    explicit fd_guard(int fd) noexcept : fd_{fd} {}
+    fd_guard(fd_guard const&) = delete;
+    fd_guard& operator=(fd_guard const&) = delete;
+    ~fd_guard();
+
+    int get() const noexcept { return fd_; }
+
+private:
+    int fd_;
+};
+
+// Opens `path` read-only; throws std::system_error on failure.
+fd_guard open_read_only(std::string const& path);
+
+struct log_file {
+    std::string path;
+    std::size_t bytes = 0;
+    log_totals expected;
+};
+
+// Generates the file on first use; later calls with the same size reuse it.
+log_file const& generated_log(std::size_t megabytes);
+
+// Asks the kernel to drop the file's pages from the page cache.
+void drop_from_page_cache(log_file const& file);
+
+// Fraction of the file's pages in the page cache, measured with mincore.
+double resident_fraction(log_file const& file);
+
+}  // namespace file_io
@@ -0,0 +1,37 @@
+#include "rss.hpp"
+
+#include <fstream>
+#include <string>
+
+namespace file_io {
+
+namespace {
+
+std::optional<std::size_t> status_field(std::string const& key) {
+    std::ifstream status{"/proc/self/status"};
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, key.size(), key) == 0 && line.size() > key.size() && line[key.size()] == ':') {
+            return std::stoull(line.substr(key.size() + 1)) * 1024;  // reported in kB
+        }
+    }
+    return std::nullopt;
+}
+
+}  // namespace
+
+bool reset_peak_rss() {
+    std::ofstream clear_refs{"/proc/self/clear_refs"};
+    clear_refs << "5" << std::flush;
+    return static_cast<bool>(clear_refs);
+}
+
+std::optional<std::size_t> current_rss() {
+    return status_field("VmRSS");
+}
+
+std::optional<std::size_t> peak_rss() {
+    return status_field("VmHWM");
+}
+
+}  // namespace file_io
@@ -0,0 +1,21 @@
+// Peak resident set size of this process over a window of time.
+//
+// Linux keeps the high-water mark in VmHWM (/proc/self/status) and resets it
+// to the current RSS when "5" is written to /proc/self/clear_refs.  The mark
+// counts file pages mapped into the process as well as anonymous memory, so a
+// mapped file shows up in it just like a buffer it was read into.
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+namespace file_io {
+
+// Starts a new window; false if the kernel does not support resetting.
+bool reset_peak_rss();
+
+// Current and peak RSS in bytes, if /proc/self/status is readable.
+std::optional<std::size_t> current_rss();
+std::optional<std::size_t> peak_rss();
+
+}  // namespace file_io
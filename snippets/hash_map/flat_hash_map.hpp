@@ -0,0 +1,328 @@
+// Open-addressing hash map with SwissTable-style metadata.
+//
+// Slots live in one flat array; next to it sits an array of control bytes,
+// one per slot (structure of arrays): empty, deleted, or "full" plus the low
+// 7 bits of the key's hash (h2).  A lookup starts at the slot picked by the
+// remaining hash bits (h1), loads 16 control bytes at once and compares them
+// all against h2 with two SSE2 instructions.  Only slots whose byte matches
+// (1 in 128 of the unrelated ones) have their key compared, so a probe
+// usually touches one cache line of metadata and one slot.  Probing is linear
+// in steps of 16 and stops at the first group containing an empty byte.
+//
+// The first 16 control bytes are mirrored past the end of the array, so a
+// group starting anywhere can be loaded without wrapping.  Erasing leaves a
+// tombstone (deleted), which keeps probe sequences intact; tombstones are
+// purged when the table next rehashes.  The table grows at 7/8 full.
+//
+// Linear probing clusters: near 7/8 full a miss scans about 2.5 groups on
+// average (and up to ~30) before it meets an empty byte, where a hit usually
+// stops in the first.  Abseil's tables step through groups quadratically for
+// that reason.
+//
+// Deliberately minimal: no allocator parameter, no heterogeneous lookup, and
+// iteration is read-only.
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace hash_map {
+
+namespace detail {
+
+using ctrl_t = std::int8_t;
+
+inline constexpr ctrl_t ctrl_empty = -128;  // 0b1000'0000
+inline constexpr ctrl_t ctrl_deleted = -2;  // 0b1111'1110; full bytes are 0..127
+inline constexpr std::size_t group_width = 16;
+
+// Bit i of every mask is set when control byte i of the group matches.
+class group {
+public:
+#if defined(__SSE2__)
+    explicit group(ctrl_t const* p) noexcept : ctrl_{_mm_loadu_si128(reinterpret_cast<__m128i const*>(p))} {}
+
+    std::uint32_t match(ctrl_t h2) const noexcept { return mask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)); }
+    std::uint32_t match_empty() const noexcept { return mask(_mm_cmpeq_epi8(_mm_set1_epi8(ctrl_empty), ctrl_)); }
+    // Empty and deleted are the only bytes below -1.
+    std::uint32_t match_empty_or_deleted() const noexcept {
+        return mask(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl_));
+    }
+    // Full bytes are the ones with the sign bit clear.
+    std::uint32_t match_full() const noexcept { return ~mask(ctrl_) & 0xffff; }
+
+private:
+    static std::uint32_t mask(__m128i v) noexcept { return static_cast<std::uint32_t>(_mm_movemask_epi8(v)); }
+
+    __m128i ctrl_;
+#else
+    explicit group(ctrl_t const* p) noexcept : ctrl_{p} {}
+
+    std::uint32_t match(ctrl_t h2) const noexcept {
+        return mask([h2](ctrl_t c) { return c == h2; });
+    }
+    std::uint32_t match_empty() const noexcept {
+        return mask([](ctrl_t c) { return c == ctrl_empty; });
+    }
+    std::uint32_t match_empty_or_deleted() const noexcept {
+        return mask([](ctrl_t c) { return c < -1; });
+    }
+    std::uint32_t match_full() const noexcept {
+        return mask([](ctrl_t c) { return c >= 0; });
+    }
+
+private:
+    template <class Pred>
+    std::uint32_t mask(Pred pred) const noexcept {
+        std::uint32_t m = 0;
+        for (std::size_t i = 0; i < group_width; ++i) {
+            m |= std::uint32_t{pred(ctrl_[i])} << i;
+        }
+        return m;
+    }
+
+    ctrl_t const* ctrl_;
+#endif
+};
+
+// std::hash<int> is the identity: without mixing, sequential keys would share
+// h2 and cluster in h1.  This is MurmurHash3's 64-bit finalizer; with only its
+// first multiply, misses at 7/8 load probed three times as many groups.
+inline std::size_t mix(std::size_t h) noexcept {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+}  // namespace detail
+
+template <class K, class V, class Hash = std::hash<K>, class Eq = std::equal_to<K>>
+class flat_hash_map {
+    using ctrl_t = detail::ctrl_t;
+    using slot_type = std::pair<K, V>;
+    static constexpr std::size_t npos = ~std::size_t{0};
+
+public:
+    class const_iterator {
+    public:
+        slot_type const& operator*() const noexcept { return map_->slots_[index_]; }
+        slot_type const* operator->() const noexcept { return &map_->slots_[index_]; }
+
+        const_iterator& operator++() noexcept {
+            index_ = map_->next_full(index_ + 1);
+            return *this;
+        }
+
+        friend bool operator==(const_iterator const&, const_iterator const&) = default;
+
+    private:
+        friend class flat_hash_map;
+        const_iterator(flat_hash_map const* map, std::size_t index) noexcept : map_{map}, index_{index} {}
+
+        flat_hash_map const* map_;
+        std::size_t index_;
+    };
+
+    flat_hash_map() = default;
+
+    // Room for at least `min_capacity` slots (a power of two, at least 16);
+    // the table grows once it is 7/8 full.
+    explicit flat_hash_map(std::size_t min_capacity) { allocate(capacity_for(min_capacity)); }
+
+    flat_hash_map(flat_hash_map&& other) noexcept { swap(other); }
+    flat_hash_map& operator=(flat_hash_map&& other) noexcept {
+        flat_hash_map{std::move(other)}.swap(*this);
+        return *this;
+    }
+    flat_hash_map(flat_hash_map const&) = delete;
+    flat_hash_map& operator=(flat_hash_map const&) = delete;
+
+    ~flat_hash_map() { release(); }
+
+    void swap(flat_hash_map& other) noexcept {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(growth_left_, other.growth_left_);
+    }
+
+    // Inserts (key, value) unless the key is present; returns the mapped value
+    // and whether it was inserted.
+    template <class KK, class VV>
+    std::pair<V*, bool> try_emplace(KK&& key, VV&& value) {
+        std::size_t const hash = hash_of(key);
+        if (std::size_t const i = find_index(key, hash); i != npos) {
+            return {&slots_[i].second, false};
+        }
+        std::size_t i = capacity_ == 0 ? npos : find_non_full(hash);
+        if (i == npos || (growth_left_ == 0 && ctrl_[i] == detail::ctrl_empty)) {
+            grow();
+            i = find_non_full(hash);
+        }
+        // Reusing a tombstone does not lengthen any probe sequence.
+        growth_left_ -= ctrl_[i] == detail::ctrl_empty;
+        std::construct_at(&slots_[i], std::forward<KK>(key), std::forward<VV>(value));
+        set_ctrl(i, h2(hash));
+        ++size_;
+        return {&slots_[i].second, true};
+    }
+
+    V* find(K const& key) noexcept {
+        std::size_t const i = find_index(key, hash_of(key));
+        return i == npos ? nullptr : &slots_[i].second;
+    }
+    V const* find(K const& key) const noexcept {
+        std::size_t const i = find_index(key, hash_of(key));
+        return i == npos ? nullptr : &slots_[i].second;
+    }
+    bool contains(K const& key) const noexcept { return find(key) != nullptr; }
+
+    bool erase(K const& key) noexcept {
+        std::size_t const i = find_index(key, hash_of(key));
+        if (i == npos) {
+            return false;
+        }
+        std::destroy_at(&slots_[i]);
+        set_ctrl(i, detail::ctrl_deleted);
+        --size_;
+        return true;
+    }
+
+    const_iterator begin() const noexcept { return {this, next_full(0)}; }
+    const_iterator end() const noexcept { return {this, capacity_}; }
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::size_t capacity() const noexcept { return capacity_; }
+    double load_factor() const noexcept {
+        return capacity_ == 0 ? 0.0 : static_cast<double>(size_) / static_cast<double>(capacity_);
+    }
+
+private:
+    static std::size_t capacity_for(std::size_t min_capacity) noexcept {
+        return std::bit_ceil(std::max(min_capacity, detail::group_width));
+    }
+    static std::size_t max_load(std::size_t capacity) noexcept { return capacity - capacity / 8; }
+    static ctrl_t h2(std::size_t hash) noexcept { return static_cast<ctrl_t>(hash & 0x7f); }
+
+    std::size_t hash_of(K const& key) const noexcept { return detail::mix(Hash{}(key)); }
+    std::size_t start(std::size_t hash) const noexcept { return (hash >> 7) & (capacity_ - 1); }
+
+    std::size_t find_index(K const& key, std::size_t hash) const noexcept {
+        if (capacity_ == 0) {
+            return npos;
+        }
+        std::size_t const mask = capacity_ - 1;
+        for (std::size_t pos = start(hash);; pos = (pos + detail::group_width) & mask) {
+            detail::group const g{ctrl_ + pos};
+            for (std::uint32_t m = g.match(h2(hash)); m != 0; m &= m - 1) {
+                std::size_t const i = (pos + static_cast<std::size_t>(std::countr_zero(m))) & mask;
+                if (Eq{}(slots_[i].first, key)) {
+                    return i;
+                }
+            }
+            if (g.match_empty() != 0) {
+                return npos;
+            }
+        }
+    }
+
+    // First empty or deleted slot on the probe sequence of `hash`.  There
+    // always is one: the table never fills up.
+    std::size_t find_non_full(std::size_t hash) const noexcept {
+        std::size_t const mask = capacity_ - 1;
+        for (std::size_t pos = start(hash);; pos = (pos + detail::group_width) & mask) {
+            if (std::uint32_t const m = detail::group{ctrl_ + pos}.match_empty_or_deleted(); m != 0) {
+                return (pos + static_cast<std::size_t>(std::countr_zero(m))) & mask;
+            }
+        }
+    }
+
+    // A full neighbour is returned straight away (the common case in a dense
+    // table); otherwise the scan skips 16 slots per step.  Past the end of the
+    // array a group would see the mirrored bytes, so those are masked off.
+    std::size_t next_full(std::size_t i) const noexcept {
+        if (i < capacity_ && ctrl_[i] >= 0) {
+            return i;
+        }
+        for (; i < capacity_; i += detail::group_width) {
+            std::uint32_t m = detail::group{ctrl_ + i}.match_full();
+            if (std::size_t const left = capacity_ - i; left < detail::group_width) {
+                m &= (std::uint32_t{1} << left) - 1;
+            }
+            if (m != 0) {
+                return i + static_cast<std::size_t>(std::countr_zero(m));
+            }
+        }
+        return capacity_;
+    }
+
+    void set_ctrl(std::size_t i, ctrl_t c) noexcept {
+        ctrl_[i] = c;
+        if (i < detail::group_width) {
+            ctrl_[capacity_ + i] = c;
+        }
+    }
+
+    void allocate(std::size_t capacity) {
+        ctrl_ = new ctrl_t[capacity + detail::group_width];
+        std::fill_n(ctrl_, capacity + detail::group_width, detail::ctrl_empty);
+        slots_ = std::allocator<slot_type>{}.allocate(capacity);
+        capacity_ = capacity;
+        growth_left_ = max_load(capacity);
+    }
+
+    void release() noexcept {
+        if (capacity_ == 0) {
+            return;
+        }
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                std::destroy_at(&slots_[i]);
+            }
+        }
+        std::allocator<slot_type>{}.deallocate(slots_, capacity_);
+        delete[] ctrl_;
+    }
+
+    // Doubles the capacity, or rehashes in place when at least half of what
+    // used up the growth budget was tombstones.
+    void grow() {
+        std::size_t const new_capacity =
+            capacity_ == 0 ? detail::group_width : size_ * 2 <= max_load(capacity_) ? capacity_ : capacity_ * 2;
+        flat_hash_map bigger;
+        bigger.allocate(new_capacity);
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (ctrl_[i] >= 0) {
+                std::size_t const hash = hash_of(slots_[i].first);
+                std::size_t const j = bigger.find_non_full(hash);
+                std::construct_at(&bigger.slots_[j], std::move(slots_[i]));
+                bigger.set_ctrl(j, h2(hash));
+            }
+        }
+        bigger.size_ = size_;
+        bigger.growth_left_ -= size_;
+        swap(bigger);
+    }
+
+    ctrl_t* ctrl_ = nullptr;
+    slot_type* slots_ = nullptr;
+    std::size_t capacity_ = 0;
+    std::size_t size_ = 0;
+    std::size_t growth_left_ = 0;
+};
+
+}  // namespace hash_map
@@ -0,0 +1,288 @@
+// std::unordered_map vs an open-addressing flat map (flat_hash_map.hpp).
+//
+// Every case works on one table sized to `capacity` slots (buckets for
+// std::unordered_map, with max_load_factor 1) and filled to `load` percent,
+// so both tables sit at the same nominal load factor.  One iteration is one
+// pass over all n keys:
+//   insert     build the table from empty (its slots or buckets already
+//              allocated, outside the timed region)
+//   find_hit   look up every key, in random order
+//   find_miss  look up n keys that are not in the table
+//   erase      erase every key, in random order, from a freshly built table
+//   iterate    sum the values
+//
+// Keys are `int`, a short string that fits the small-string buffer (11
+// characters) and a long string with a shared 28-character prefix (38
+// characters, heap allocated, and comparisons have to get past the prefix).
+// Each case also reports `bytes_per_element`: the heap bytes requested while
+// building the table (slots or nodes, bucket or control arrays, and the
+// string keys' own buffers) divided by n.  malloc adds its per-chunk header on
+// top of that, which costs the node-based table once per element.
+
+#include "flat_hash_map.hpp"
+
+#include <cpplearn/alloc_counter.hpp>
+#include <cpplearn/bench.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+
+using value_type = std::uint64_t;
+
+constexpr std::size_t capacity = std::size_t{1} << 16;
+
+// The i-th distinct key.  Multiplying by an odd constant is a bijection on
+// 32-bit integers, so distinct i give distinct keys in a scrambled order.
+template <class K>
+K make_key(std::uint32_t i) {
+    std::uint32_t const x = i * 2654435761u;
+    if constexpr (std::is_same_v<K, int>) {
+        return static_cast<int>(x);
+    } else {
+        std::string digits = std::to_string(x);
+        digits.insert(0, 10 - digits.size(), '0');
+        return K{"k" + digits};
+    }
+}
+
+struct long_string : std::string {
+    explicit long_string(std::string const& s) : std::string{"tenant/eu-west/session/user:" + s.substr(1)} {}
+};
+
+template <>
+long_string make_key<long_string>(std::uint32_t i) {
+    return long_string{make_key<std::string>(i)};
+}
+
+template <class K>
+struct key_set {
+    std::vector<K> present;  // in insertion order
+    std::vector<K> shuffled;
+    std::vector<K> absent;
+};
+
+template <class K>
+key_set<K> make_keys(std::size_t n) {
+    key_set<K> keys;
+    for (std::uint32_t i = 0; i < n; ++i) {
+        keys.present.push_back(make_key<K>(i));
+        keys.absent.push_back(make_key<K>(static_cast<std::uint32_t>(n) + i));
+    }
+    keys.shuffled = keys.present;
+    std::shuffle(keys.shuffled.begin(), keys.shuffled.end(), std::mt19937{5});
+    return keys;
+}
+
+// std::hash<std::string> also hashes long_string, which is a std::string.
+template <class K>
+struct hasher {
+    using type = std::hash<std::string>;
+};
+template <>
+struct hasher<int> {
+    using type = std::hash<int>;
+};
+
+template <class K>
+struct std_map {
+    static constexpr char const* name = "unordered_map";
+    using map = std::unordered_map<K, value_type, typename hasher<K>::type>;
+
+    static map make() {
+        map m;
+        m.max_load_factor(1.0f);
+        m.rehash(capacity);
+        return m;
+    }
+    static value_type const* find(map const& m, K const& k) {
+        auto const it = m.find(k);
+        return it == m.end() ? nullptr : &it->second;
+    }
+};
+
+template <class K>
+struct flat_map {
+    static constexpr char const* name = "flat";
+    using map = hash_map::flat_hash_map<K, value_type, typename hasher<K>::type>;
+
+    static map make() { return map{capacity}; }
+    static value_type const* find(map const& m, K const& k) { return m.find(k); }
+};
+
+template <class Table, class K>
+typename Table::map build(std::vector<K> const& keys) {
+    auto m = Table::make();
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        m.try_emplace(keys[i], value_type{i});
+    }
+    return m;
+}
+
+// Counters every case reports; `keys` builds one more table to measure it.
+template <class Table, class K>
+void report(state& st, std::vector<K> const& keys) {
+    cpplearn::bench::alloc_scope allocs;
+    auto const m = build<Table>(keys);
+    auto const bytes = static_cast<double>(allocs.delta().bytes);
+    st.set_counter("bytes_per_element", bytes / static_cast<double>(keys.size()));
+    st.set_counter("load_factor", m.load_factor());
+    st.set_items_processed(st.iterations() * keys.size());
+}
+
+std::size_t element_count(state& st) {
+    return capacity * static_cast<std::size_t>(st.arg(0)) / 100;
+}
+
+template <class Table, class K>
+void bm_insert(state& st) {
+    auto const keys = make_keys<K>(element_count(st));
+    std::optional<typename Table::map> m;
+    for (auto _ : st) {
+        st.pause_timing();
+        m.reset();
+        m.emplace(Table::make());
+        st.resume_timing();
+        for (std::size_t i = 0; i < keys.present.size(); ++i) {
+            m->try_emplace(keys.present[i], value_type{i});
+        }
+        do_not_optimize(m->size());
+    }
+    if (m->size() != keys.present.size()) {
+        st.error("keys lost on insert");
+        return;
+    }
+    report<Table>(st, keys.present);
+}
+
+template <class Table, class K>
+void bm_find_hit(state& st) {
+    auto const keys = make_keys<K>(element_count(st));
+    auto const m = build<Table>(keys.present);
+    value_type sum = 0;
+    for (auto _ : st) {
+        sum = 0;
+        for (auto const& k : keys.shuffled) {
+            value_type const* v = Table::find(m, k);
+            sum += v != nullptr ? *v : ~value_type{0};
+        }
+        do_not_optimize(sum);
+    }
+    value_type const n = keys.present.size();
+    if (sum != n * (n - 1) / 2) {
+        st.error("lookup returned a wrong value");
+        return;
+    }
+    report<Table>(st, keys.present);
+}
+
+template <class Table, class K>
+void bm_find_miss(state& st) {
+    auto const keys = make_keys<K>(element_count(st));
+    auto const m = build<Table>(keys.present);
+    std::size_t found = 0;
+    for (auto _ : st) {
+        found = 0;
+        for (auto const& k : keys.absent) {
+            found += Table::find(m, k) != nullptr;
+        }
+        do_not_optimize(found);
+    }
+    if (found != 0) {
+        st.error("found a key that was never inserted");
+        return;
+    }
+    report<Table>(st, keys.present);
+}
+
+template <class Table, class K>
+void bm_erase(state& st) {
+    auto const keys = make_keys<K>(element_count(st));
+    std::optional<typename Table::map> m;
+    std::size_t erased = 0;
+    for (auto _ : st) {
+        st.pause_timing();
+        m.reset();
+        m.emplace(build<Table>(keys.present));
+        st.resume_timing();
+        erased = 0;
+        for (auto const& k : keys.shuffled) {
+            erased += m->erase(k);
+        }
+        do_not_optimize(erased);
+    }
+    if (erased != keys.present.size() || !m->empty() || Table::find(*m, keys.present[0]) != nullptr) {
+        st.error("erase missed keys");
+        return;
+    }
+    report<Table>(st, keys.present);
+}
+
+template <class Table, class K>
+void bm_iterate(state& st) {
+    auto const keys = make_keys<K>(element_count(st));
+    auto const m = build<Table>(keys.present);
+    value_type sum = 0;
+    for (auto _ : st) {
+        sum = 0;
+        for (auto const& [key, value] : m) {
+            sum += value;
+        }
+        do_not_optimize(sum);
+    }
+    value_type const n = keys.present.size();
+    if (sum != n * (n - 1) / 2) {
+        st.error("iteration missed elements");
+        return;
+    }
+    report<Table>(st, keys.present);
+}
+
+using bench_fn = void (*)(state&);
+
+template <template <class> class Table, class K>
+void add_table(std::vector<std::pair<std::string, bench_fn>>& out, std::string const& key_name) {
+    using T = Table<K>;
+    std::string const suffix = std::string{"/"} + T::name + "/" + key_name;
+    out.emplace_back("insert" + suffix, bm_insert<T, K>);
+    out.emplace_back("find_hit" + suffix, bm_find_hit<T, K>);
+    out.emplace_back("find_miss" + suffix, bm_find_miss<T, K>);
+    out.emplace_back("erase" + suffix, bm_erase<T, K>);
+    out.emplace_back("iterate" + suffix, bm_iterate<T, K>);
+}
+
+template <class K>
+void add_key(std::vector<std::pair<std::string, bench_fn>>& out, std::string const& key_name) {
+    add_table<std_map, K>(out, key_name);
+    add_table<flat_map, K>(out, key_name);
+}
+
+// Registered grouped by operation, then key type, so the two tables sit on
+// adjacent lines of the report.
+[[maybe_unused]] bool const registered = [] {
+    std::vector<std::pair<std::string, bench_fn>> cases;
+    add_key<int>(cases, "int");
+    add_key<std::string>(cases, "short_string");
+    add_key<long_string>(cases, "long_string");
+    std::stable_sort(cases.begin(), cases.end(), [](auto const& a, auto const& b) {
+        auto const op = [](std::string const& name) { return name.substr(0, name.find('/')); };
+        return op(a.first) < op(b.first);
+    });
+    for (auto const& [name, fn] : cases) {
+        cpplearn::bench::register_benchmark(name, fn)->args_product({{25, 50, 75, 87}})->arg_names({"load"});
+    }
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,135 @@
+// What cpplearn/trace.hpp costs per event, and what exporting costs.
+//
+// One iteration calls one step (steps.hpp): the same short computation,
+// instrumented differently.  `overhead_ns` is the time per call minus that of
+// the uninstrumented step, timed right after each case for the same number
+// of calls.  `compiled_out` should be indistinguishable from zero;
+// `tsc_reads` is the clock alone, and `tsc_scope` minus `tsc_reads` the cost
+// of appending the event to the thread's buffer.  The threaded cases record
+// from several threads at once: with per-thread buffers the per-event cost
+// does not grow with the thread count.
+//
+// export/chrome_json writes one full buffer (buffer_capacity events) as
+// Chrome trace JSON into memory.
+
+#include "steps.hpp"
+
+#include <cpplearn/bench.hpp>
+#include <cpplearn/trace.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+namespace {
+
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+namespace trace = cpplearn::trace;
+namespace in = instrumentation;
+
+using step_fn = std::uint64_t (*)(std::uint64_t);
+
+double plain_seconds(std::uint64_t calls) {
+    auto const start = std::chrono::steady_clock::now();
+    std::uint64_t x = 1;
+    for (std::uint64_t i = 0; i < calls; ++i) {
+        x = in::step_plain(x);
+    }
+    do_not_optimize(x);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// `events_per_call` is what the step should leave in this thread's buffer.
+void bm_event(state& st, step_fn step, std::uint64_t events_per_call) {
+    std::uint64_t const before = trace::local_buffer().recorded();
+    std::uint64_t x = 1;
+    for (auto _ : st) {
+        x = step(x);
+    }
+    do_not_optimize(x);
+    if (trace::local_buffer().recorded() - before != st.iterations() * events_per_call) {
+        st.error("unexpected number of recorded events");
+        return;
+    }
+    double const calls = static_cast<double>(st.iterations());
+    double const overhead = (st.elapsed_seconds() - plain_seconds(st.iterations())) / calls;
+    st.set_counter("overhead_ns", overhead * 1e9);
+    st.set_items_processed(st.iterations());
+}
+
+void bm_event_threads(state& st, step_fn step) {
+    auto const threads = static_cast<unsigned>(st.arg(0));
+    st.run_threads(threads, [step](unsigned, std::uint64_t iterations) {
+        std::uint64_t x = 1;
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            x = step(x);
+        }
+        do_not_optimize(x);
+    });
+    st.set_items_processed(st.iterations() * threads);
+}
+
+void bm_export(state& st) {
+    trace::registry::instance().clear();
+    std::uint64_t const before = trace::local_buffer().recorded();
+    std::uint64_t x = 1;
+    for (std::size_t i = 0; i < trace::buffer_capacity; ++i) {
+        x = in::step_tsc_scope(x);
+    }
+    do_not_optimize(x);
+    std::uint64_t events = 0;
+    trace::registry::instance().for_each_buffer([&](trace::thread_buffer const& b) {
+        events += b.recorded() > trace::buffer_capacity ? trace::buffer_capacity : b.recorded();
+    });
+    if (trace::local_buffer().recorded() - before != trace::buffer_capacity) {
+        st.error("events missing from the buffer");
+        return;
+    }
+
+    std::size_t bytes = 0;
+    std::string json;
+    for (auto _ : st) {
+        std::ostringstream out;
+        trace::write_chrome_trace(out);
+        json = std::move(out).str();
+        bytes = json.size();
+    }
+    std::size_t complete_events = 0;
+    for (auto pos = json.find(R"("ph":"X")"); pos != std::string::npos; pos = json.find(R"("ph":"X")", pos + 1)) {
+        ++complete_events;
+    }
+    if (complete_events != events || !json.ends_with("]}\n")) {
+        st.error("exported JSON does not hold every event");
+        return;
+    }
+    st.set_items_processed(st.iterations() * events);
+    st.set_bytes_processed(st.iterations() * bytes);
+    st.set_counter("bytes_per_event", static_cast<double>(bytes) / static_cast<double>(events));
+}
+CPPLEARN_BENCHMARK_NAMED("export/chrome_json", bm_export);
+
+[[maybe_unused]] bool const registered = [] {
+    using cpplearn::bench::register_benchmark;
+    struct variant {
+        char const* name;
+        step_fn step;
+        std::uint64_t events;
+    };
+    for (auto const& v : {variant{"plain", in::step_plain, 0}, variant{"compiled_out", in::step_compiled_out, 0},
+                          variant{"tsc_reads", in::step_tsc_reads, 0}, variant{"tsc_scope", in::step_tsc_scope, 1},
+                          variant{"trace_macro", in::step_traced, 1},
+                          variant{"monotonic_scope", in::step_monotonic_scope, 1}}) {
+        register_benchmark(std::string{"event/"} + v.name, [v](state& st) { bm_event(st, v.step, v.events); });
+    }
+    register_benchmark("event_threads/tsc_scope", [](state& st) { bm_event_threads(st, in::step_tsc_scope); })
+        ->args_product({cpplearn::bench::thread_counts()})
+        ->arg_names({"threads"});
+    register_benchmark("event_threads/plain", [](state& st) { bm_event_threads(st, in::step_plain); })
+        ->args_product({cpplearn::bench::thread_counts()})
+        ->arg_names({"threads"});
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,33 @@
+// The instrumented function, in one variant per way of instrumenting it.
+//
+// Each variant wraps the same few nanoseconds of work in its own
+// out-of-line function, so the calls cost the same and the difference
+// between two variants is the instrumentation alone.  The variants live in
+// two translation units: steps_off.cpp is compiled with CPPLEARN_TRACE=0 and
+// steps_on.cpp with CPPLEARN_TRACE=1, whatever the build option says.
+#pragma once
+
+#include <cstdint>
+
+namespace instrumentation {
+
+// A short dependent chain, so the work cannot overlap much with the clock
+// reads around it.
+inline std::uint64_t work(std::uint64_t x) noexcept {
+    x ^= x >> 31;
+    x *= 0x7fb5d329728ea185ull;
+    x ^= x >> 27;
+    return x;
+}
+
+// steps_off.cpp
+std::uint64_t step_plain(std::uint64_t x);         // no instrumentation
+std::uint64_t step_compiled_out(std::uint64_t x);  // CPPLEARN_TRACE_SCOPE with tracing off
+
+// steps_on.cpp
+std::uint64_t step_traced(std::uint64_t x);          // CPPLEARN_TRACE_SCOPE with tracing on
+std::uint64_t step_tsc_reads(std::uint64_t x);       // two rdtsc, nothing recorded
+std::uint64_t step_tsc_scope(std::uint64_t x);       // trace::scope<tsc_clock>
+std::uint64_t step_monotonic_scope(std::uint64_t x);  // trace::scope<monotonic_clock>
+
+}  // namespace instrumentation
@@ -0,0 +1,20 @@
+// Tracing compiled out, regardless of the CPPLEARN_TRACE build option.
+#undef CPPLEARN_TRACE
+#define CPPLEARN_TRACE 0
+
+#include "steps.hpp"
+
+#include <cpplearn/trace.hpp>
+
+namespace instrumentation {
+
+std::uint64_t step_plain(std::uint64_t x) {
+    return work(x);
+}
+
+std::uint64_t step_compiled_out(std::uint64_t x) {
+    CPPLEARN_TRACE_SCOPE("step");
+    return work(x);
+}
+
+}  // namespace instrumentation
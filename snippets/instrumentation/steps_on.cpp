@@ -0,0 +1,36 @@
+// Tracing compiled in, regardless of the CPPLEARN_TRACE build option.
+#undef CPPLEARN_TRACE
+#define CPPLEARN_TRACE 1
+
+#include "steps.hpp"
+
+#include <cpplearn/bench.hpp>
+#include <cpplearn/trace.hpp>
+
+namespace instrumentation {
+
+namespace trace = cpplearn::trace;
+
+std::uint64_t step_traced(std::uint64_t x) {
+    CPPLEARN_TRACE_SCOPE("step");
+    return work(x);
+}
+
+std::uint64_t step_tsc_reads(std::uint64_t x) {
+    std::uint64_t const begin = trace::tsc_clock::now();
+    x = work(x);
+    cpplearn::bench::do_not_optimize(trace::tsc_clock::now() - begin);
+    return x;
+}
+
+std::uint64_t step_tsc_scope(std::uint64_t x) {
+    trace::scope<trace::tsc_clock> const s{"step"};
+    return work(x);
+}
+
+std::uint64_t step_monotonic_scope(std::uint64_t x) {
+    trace::scope<trace::monotonic_clock> const s{"step"};
+    return work(x);
+}
+
+}  // namespace instrumentation
@@ -0,0 +1,126 @@
+// Chase-Lev work-stealing deque, in the C11 formulation of Lê, Pop, Cohen and
+// Zappa Nardelli ("Correct and Efficient Work-Stealing for Weak Memory
+// Models", PPoPP 2013).
+//
+// The owner pushes and pops at the bottom without atomic read-modify-write
+// operations in the common case; thieves take from the top with a CAS.  The
+// only contended case is the last element, which owner and thieves settle
+// with the same CAS on `top_`.  The circular buffer grows when full; old
+// buffers are kept until the deque is destroyed because a thief may still be
+// reading from one.
+//
+// T must be trivially copyable: cells are relaxed atomics so a thief can read
+// a slot the owner is concurrently overwriting (it then fails its CAS).
+//
+// ThreadSanitizer does not model standalone fences, so a TSan build warns
+// about them (-Wtsan) and checks this class less precisely than the others.
+#pragma once
+
+#include "common.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace lockfree {
+
+template <class T>
+class chase_lev_deque {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    explicit chase_lev_deque(std::size_t capacity = 64) {
+        ring_mask(capacity, 1, "chase_lev_deque");
+        buffers_.push_back(std::make_unique<buffer>(capacity));
+        buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+    }
+
+    // Owner thread only.
+    void push(T value) {
+        std::int64_t const b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t const t = top_.load(std::memory_order_acquire);
+        buffer* a = buffer_.load(std::memory_order_relaxed);
+        if (b - t > static_cast<std::int64_t>(a->capacity) - 1) {
+            a = grow(a, t, b);
+        }
+        a->store(b, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner thread only.
+    std::optional<T> pop() {
+        std::int64_t const b = bottom_.load(std::memory_order_relaxed) - 1;
+        buffer* a = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        T value = a->load(b);
+        if (t == b) {
+            // Last element: race the thieves for it.
+            bool const won =
+                top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            if (!won) {
+                return std::nullopt;
+            }
+        }
+        return value;
+    }
+
+    // Any thread.  Empty also when it lost a race; callers just try elsewhere.
+    std::optional<T> steal() {
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t const b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) {
+            return std::nullopt;
+        }
+        buffer* a = buffer_.load(std::memory_order_acquire);
+        T value = a->load(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+private:
+    struct buffer {
+        explicit buffer(std::size_t cap) : capacity{cap}, cells{new std::atomic<T>[cap]} {}
+
+        T load(std::int64_t i) const noexcept {
+            return cells[static_cast<std::size_t>(i) & (capacity - 1)].load(std::memory_order_relaxed);
+        }
+        void store(std::int64_t i, T value) noexcept {
+            cells[static_cast<std::size_t>(i) & (capacity - 1)].store(value, std::memory_order_relaxed);
+        }
+
+        std::size_t capacity;  // power of two
+        std::unique_ptr<std::atomic<T>[]> cells;
+    };
+
+    buffer* grow(buffer* old, std::int64_t t, std::int64_t b) {
+        buffers_.push_back(std::make_unique<buffer>(old->capacity * 2));
+        buffer* bigger = buffers_.back().get();
+        for (std::int64_t i = t; i < b; ++i) {
+            bigger->store(i, old->load(i));
+        }
+        buffer_.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    alignas(cache_line) std::atomic<std::int64_t> top_{0};
+    alignas(cache_line) std::atomic<std::int64_t> bottom_{0};
+    alignas(cache_line) std::atomic<buffer*> buffer_{nullptr};
+    std::vector<std::unique_ptr<buffer>> buffers_;  // owner only
+};
+
+}  // namespace lockfree
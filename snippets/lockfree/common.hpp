@@ -0,0 +1,150 @@
+// Shared pieces of the lock-free snippets: cache-line size, spin back-off and
+// the mutex-based baselines every structure is compared with.
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace lockfree {
+
+// std::hardware_destructive_interference_size is not ABI-stable (GCC warns
+// when it is used in a header); 64 bytes is right for current x86-64 and most
+// AArch64 parts.
+inline constexpr std::size_t cache_line = 64;
+
+// Returns the index mask of a ring of `capacity` slots, which is indexed with
+// `& mask` and so must be a power of two of at least `minimum`.
+inline std::size_t ring_mask(std::size_t capacity, std::size_t minimum, char const* what) {
+    if (capacity < minimum || !std::has_single_bit(capacity)) {
+        std::string message = std::string{what} + " capacity must be a power of two";
+        if (minimum > 1) {
+            message += " >= " + std::to_string(minimum);
+        }
+        throw std::invalid_argument{message};
+    }
+    return capacity - 1;
+}
+
+// Spins with a CPU pause hint, then starts yielding.  Yielding matters when
+// there are more threads than cores: a spinning consumer would otherwise burn
+// the producer's time slice.
+class backoff {
+public:
+    void pause() noexcept {
+        if (spins_ < 64) {
+            ++spins_;
+#if defined(__x86_64__) || defined(__i386__)
+            _mm_pause();
+#endif
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    void reset() noexcept { spins_ = 0; }
+
+private:
+    unsigned spins_ = 0;
+};
+
+// Bounded FIFO guarded by one mutex: the baseline for both queues.
+template <class T>
+class mutex_queue {
+public:
+    explicit mutex_queue(std::size_t capacity) : capacity_{capacity} {}
+
+    bool try_push(T const& value) {
+        std::lock_guard lock{mutex_};
+        if (items_.size() == capacity_) {
+            return false;
+        }
+        items_.push_back(value);
+        return true;
+    }
+
+    bool try_pop(T& out) {
+        std::lock_guard lock{mutex_};
+        if (items_.empty()) {
+            return false;
+        }
+        out = items_.front();
+        items_.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::deque<T> items_;
+    std::size_t capacity_;
+};
+
+// LIFO guarded by one mutex: the baseline for the Treiber stack.
+template <class T>
+class mutex_stack {
+public:
+    void push(T value) {
+        std::lock_guard lock{mutex_};
+        items_.push_back(std::move(value));
+    }
+
+    std::optional<T> pop() {
+        std::lock_guard lock{mutex_};
+        if (items_.empty()) {
+            return std::nullopt;
+        }
+        T value = std::move(items_.back());
+        items_.pop_back();
+        return value;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<T> items_;
+};
+
+// Work-stealing deque guarded by one mutex: the baseline for Chase-Lev.
+template <class T>
+class mutex_deque {
+public:
+    void push(T value) {
+        std::lock_guard lock{mutex_};
+        items_.push_back(value);
+    }
+
+    std::optional<T> pop() {
+        std::lock_guard lock{mutex_};
+        if (items_.empty()) {
+            return std::nullopt;
+        }
+        T value = items_.back();
+        items_.pop_back();
+        return value;
+    }
+
+    std::optional<T> steal() {
+        std::lock_guard lock{mutex_};
+        if (items_.empty()) {
+            return std::nullopt;
+        }
+        T value = items_.front();
+        items_.pop_front();
+        return value;
+    }
+
+private:
+    std::mutex mutex_;
+    std::deque<T> items_;
+};
+
+}  // namespace lockfree
@@ -0,0 +1,117 @@
+#include "hazard_pointers.hpp"
+
+#include "common.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace lockfree::hazard {
+
+namespace {
+
+struct retired_node {
+    void* ptr;
+    void (*deleter)(void*);
+};
+
+struct alignas(cache_line) hazard_record {
+    std::atomic<void*> hazard{nullptr};
+    std::atomic<bool> owned{false};
+};
+
+hazard_record records[max_threads];
+
+// Retired nodes of threads that exited before they could be freed.
+std::mutex orphan_mutex;
+std::vector<retired_node> orphans;
+
+// Frees every node in `nodes` that no hazard slot points to; keeps the rest.
+void scan(std::vector<retired_node>& nodes) {
+    std::vector<void*> protected_ptrs;
+    protected_ptrs.reserve(max_threads);
+    for (auto& record : records) {
+        if (void* p = record.hazard.load(std::memory_order_seq_cst)) {
+            protected_ptrs.push_back(p);
+        }
+    }
+    std::sort(protected_ptrs.begin(), protected_ptrs.end());
+
+    auto keep = std::partition(nodes.begin(), nodes.end(), [&](retired_node const& n) {
+        return std::binary_search(protected_ptrs.begin(), protected_ptrs.end(), n.ptr);
+    });
+    for (auto it = keep; it != nodes.end(); ++it) {
+        it->deleter(it->ptr);
+    }
+    nodes.erase(keep, nodes.end());
+}
+
+class thread_record {
+public:
+    thread_record() {
+        for (auto& r : records) {
+            bool expected = false;
+            if (!r.owned.load(std::memory_order_relaxed) &&
+                r.owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                record_ = &r;
+                return;
+            }
+        }
+        throw std::runtime_error{"too many threads using hazard pointers"};
+    }
+
+    ~thread_record() {
+        record_->hazard.store(nullptr, std::memory_order_release);
+        scan(retired_);
+        if (!retired_.empty()) {
+            std::lock_guard lock{orphan_mutex};
+            orphans.insert(orphans.end(), retired_.begin(), retired_.end());
+        }
+        record_->owned.store(false, std::memory_order_release);
+    }
+
+    std::atomic<void*>& hazard() noexcept { return record_->hazard; }
+
+    void retire(retired_node node) {
+        retired_.push_back(node);
+        // Scanning costs O(max_threads); amortize it over as many retirements.
+        if (retired_.size() >= 2 * max_threads) {
+            scan(retired_);
+        }
+    }
+
+private:
+    hazard_record* record_ = nullptr;
+    std::vector<retired_node> retired_;
+};
+
+thread_record& this_thread_record() {
+    thread_local thread_record record;
+    return record;
+}
+
+}  // namespace
+
+std::atomic<void*>& slot() {
+    return this_thread_record().hazard();
+}
+
+void retire(void* ptr, void (*deleter)(void*)) {
+    this_thread_record().retire({ptr, deleter});
+}
+
+void reclaim() {
+    std::vector<retired_node> pending;
+    {
+        std::lock_guard lock{orphan_mutex};
+        pending.swap(orphans);
+    }
+    scan(pending);
+    if (!pending.empty()) {
+        std::lock_guard lock{orphan_mutex};
+        orphans.insert(orphans.end(), pending.begin(), pending.end());
+    }
+}
+
+}  // namespace lockfree::hazard
@@ -0,0 +1,57 @@
+// A minimal hazard-pointer domain for safe memory reclamation.
+//
+// A lock-free structure cannot free a node as soon as it unlinks it: another
+// thread may have loaded the pointer a moment earlier and be about to read
+// through it.  With hazard pointers each thread publishes the one pointer it
+// is about to dereference; unlinked nodes are `retire`d instead of deleted and
+// only freed by a later scan that finds them in no thread's hazard slot.
+//
+// This version has one process-wide domain, one hazard slot per thread and a
+// fixed upper bound on concurrently registered threads.  A thread's slot and
+// its pending retired nodes are handed back when the thread exits.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace lockfree::hazard {
+
+inline constexpr std::size_t max_threads = 256;
+
+// The calling thread's hazard slot (registers the thread on first use).
+std::atomic<void*>& slot();
+
+// Queues `ptr` for deletion once no hazard slot holds it.
+void retire(void* ptr, void (*deleter)(void*));
+
+// Frees every retired node that is not currently protected, including those
+// left behind by exited threads.  Only needed to make leak checks quiet.
+void reclaim();
+
+// Loads `src` and publishes it in this thread's slot, retrying until the
+// published value is still current (so it cannot have been retired and
+// scanned in between).
+template <class T>
+T* protect(std::atomic<T*> const& src) {
+    auto& hp = slot();
+    T* ptr = src.load(std::memory_order_relaxed);
+    for (;;) {
+        hp.store(ptr, std::memory_order_seq_cst);
+        T* const again = src.load(std::memory_order_seq_cst);
+        if (again == ptr) {
+            return ptr;
+        }
+        ptr = again;
+    }
+}
+
+inline void clear() {
+    slot().store(nullptr, std::memory_order_release);
+}
+
+template <class T>
+void retire(T* ptr) {
+    retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+}
+
+}  // namespace lockfree::hazard
@@ -0,0 +1,86 @@
+// Bounded multi-producer multi-consumer queue (Dmitry Vyukov's design).
+//
+// Every cell carries a sequence number that says whose turn it is: a producer
+// at position p may fill the cell when its sequence is p, a consumer may empty
+// it when the sequence is p + 1.  Producers and consumers claim positions with
+// a CAS on their own counter and hand the cell over with a release store of
+// the next sequence value, so there is no shared lock and no ABA problem.
+#pragma once
+
+#include "common.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace lockfree {
+
+template <class T>
+class mpmc_queue {
+public:
+    explicit mpmc_queue(std::size_t capacity)
+        : mask_{ring_mask(capacity, 2, "mpmc_queue")}, cells_{new cell[capacity]} {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool try_push(T const& value) {
+        std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        cell* c;
+        for (;;) {
+            c = &cells_[pos & mask_];
+            std::size_t const seq = c->sequence.load(std::memory_order_acquire);
+            auto const diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        c->data = value;
+        c->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& out) {
+        std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        cell* c;
+        for (;;) {
+            c = &cells_[pos & mask_];
+            std::size_t const seq = c->sequence.load(std::memory_order_acquire);
+            auto const diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;  // empty
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(c->data);
+        c->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct cell {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+
+    alignas(cache_line) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(cache_line) std::atomic<std::size_t> dequeue_pos_{0};
+    alignas(cache_line) std::size_t const mask_;
+    std::unique_ptr<cell[]> const cells_;
+};
+
+}  // namespace lockfree
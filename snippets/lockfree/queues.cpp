@@ -0,0 +1,136 @@
+// SPSC ring and MPMC queue vs a mutex-guarded std::deque.
+//
+// One iteration moves one item from a producer to a consumer.  Every run
+// checks its result: the SPSC consumer must see 0, 1, 2, ... in order, and the
+// MPMC consumers together must see every produced value exactly once (checked
+// through a sum) with each producer's values in order.
+
+#include "common.hpp"
+#include "mpmc_queue.hpp"
+#include "scaling.hpp"
+#include "spsc_ring.hpp"
+
+#include <cpplearn/bench.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::state;
+
+constexpr std::size_t queue_capacity = 1024;
+constexpr unsigned producer_shift = 40;
+
+template <class Queue>
+void bm_spsc(state& st) {
+    Queue q{queue_capacity};
+    std::atomic<bool> in_order{true};
+    st.run_threads(2, [&](unsigned thread, std::uint64_t iterations) {
+        lockfree::backoff wait;
+        if (thread == 0) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                while (!q.try_push(i)) {
+                    wait.pause();
+                }
+                wait.reset();
+            }
+        } else {
+            std::uint64_t value = 0;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                while (!q.try_pop(value)) {
+                    wait.pause();
+                }
+                wait.reset();
+                if (value != i) {
+                    in_order.store(false, std::memory_order_relaxed);
+                }
+            }
+        }
+    });
+    if (!in_order.load()) {
+        st.error("items arrived out of order");
+    }
+    st.set_items_processed(st.iterations());
+}
+CPPLEARN_BENCHMARK(bm_spsc<lockfree::spsc_ring<std::uint64_t>>);
+CPPLEARN_BENCHMARK(bm_spsc<lockfree::mpmc_queue<std::uint64_t>>);
+CPPLEARN_BENCHMARK(bm_spsc<lockfree::mutex_queue<std::uint64_t>>);
+CPPLEARN_BENCHMARK_NAMED("stress/spsc_ring", bm_spsc<lockfree::spsc_ring<std::uint64_t>>)
+    ->iterations(lockfree::stress_iterations * 10)
+    ->repetitions(1);
+
+// Half the threads produce, half consume.
+template <class Queue>
+void bm_mpmc(state& st) {
+    auto const threads = static_cast<unsigned>(st.arg(0));
+    unsigned const producers = threads / 2;
+    unsigned const consumers = threads - producers;
+    std::uint64_t const total = st.iterations() * producers;
+
+    Queue q{queue_capacity};
+    std::atomic<std::uint64_t> consumed{0};
+    std::atomic<std::uint64_t> checksum{0};
+    std::atomic<bool> in_order{true};
+
+    st.run_threads(threads, [&](unsigned thread, std::uint64_t iterations) {
+        lockfree::backoff wait;
+        if (thread < producers) {
+            std::uint64_t const tag = std::uint64_t{thread} << producer_shift;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                while (!q.try_push(tag | i)) {
+                    wait.pause();
+                }
+                wait.reset();
+            }
+            return;
+        }
+        std::vector<std::uint64_t> next_expected(producers, 0);
+        std::uint64_t local_sum = 0;
+        std::uint64_t value = 0;
+        while (consumed.load(std::memory_order_relaxed) < total) {
+            if (!q.try_pop(value)) {
+                wait.pause();
+                continue;
+            }
+            wait.reset();
+            consumed.fetch_add(1, std::memory_order_relaxed);
+            local_sum += value;
+            auto const producer = static_cast<unsigned>(value >> producer_shift);
+            std::uint64_t const seq = value & ((std::uint64_t{1} << producer_shift) - 1);
+            if (seq < next_expected[producer]) {
+                in_order.store(false, std::memory_order_relaxed);
+            }
+            next_expected[producer] = seq + 1;
+        }
+        checksum.fetch_add(local_sum, std::memory_order_relaxed);
+    });
+
+    std::uint64_t expected = 0;
+    for (unsigned p = 0; p < producers; ++p) {
+        std::uint64_t const n = st.iterations();
+        expected += n * (std::uint64_t{p} << producer_shift) + n * (n - 1) / 2;
+    }
+    if (checksum.load() != expected) {
+        st.error("items lost or duplicated");
+    } else if (!in_order.load()) {
+        st.error("a producer's items arrived out of order");
+    }
+    st.set_items_processed(total);
+    st.set_counter("producers", producers);
+    st.set_counter("consumers", consumers);
+}
+CPPLEARN_BENCHMARK(bm_mpmc<lockfree::mpmc_queue<std::uint64_t>>)
+    ->args_product({lockfree::paired_thread_counts()})
+    ->arg_names({"threads"});
+CPPLEARN_BENCHMARK(bm_mpmc<lockfree::mutex_queue<std::uint64_t>>)
+    ->args_product({lockfree::paired_thread_counts()})
+    ->arg_names({"threads"});
+CPPLEARN_BENCHMARK_NAMED("stress/mpmc_queue", bm_mpmc<lockfree::mpmc_queue<std::uint64_t>>)
+    ->arg(lockfree::stress_threads)
+    ->arg_names({"threads"})
+    ->iterations(lockfree::stress_iterations)
+    ->repetitions(1);
+
+}  // namespace
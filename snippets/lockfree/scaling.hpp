@@ -0,0 +1,31 @@
+// Thread-count sweeps shared by the lock-free benchmarks.
+#pragma once
+
+#include <cpplearn/bench.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace lockfree {
+
+// Thread counts for benchmarks that need at least two threads (one producer,
+// one consumer): 2, 4, ... up to all CPUs, or just 2 on a single-CPU machine.
+inline std::vector<std::int64_t> paired_thread_counts() {
+    std::vector<std::int64_t> counts;
+    for (std::int64_t n : cpplearn::bench::thread_counts()) {
+        if (n >= 2) {
+            counts.push_back(n);
+        }
+    }
+    if (counts.empty()) {
+        counts.push_back(2);
+    }
+    return counts;
+}
+
+// Stress runs oversubscribe the machine on purpose so that threads are
+// preempted at arbitrary points; run them under -DCPPLEARN_SANITIZER=thread.
+inline constexpr std::int64_t stress_threads = 8;
+inline constexpr std::uint64_t stress_iterations = 20'000;
+
+}  // namespace lockfree
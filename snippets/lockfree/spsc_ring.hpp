@@ -0,0 +1,66 @@
+// Single-producer single-consumer ring buffer.
+//
+// The producer owns `tail_`, the consumer owns `head_`; each publishes its
+// index with a release store and reads the other's with an acquire load, which
+// is all the ordering a slot hand-off needs.  Each side also keeps a private
+// copy of the other side's index and refreshes it only when the ring looks
+// full (or empty), so in steady state neither side touches the other's cache
+// line.
+#pragma once
+
+#include "common.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace lockfree {
+
+template <class T>
+class spsc_ring {
+public:
+    explicit spsc_ring(std::size_t capacity)
+        : mask_{ring_mask(capacity, 1, "spsc_ring")}, slots_{new T[capacity]} {}
+
+    // Producer thread only.
+    bool try_push(T const& value) {
+        std::size_t const tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ > mask_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ > mask_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer thread only.
+    bool try_pop(T& out) {
+        std::size_t const head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_) {
+                return false;
+            }
+        }
+        out = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    // Consumer-owned line.
+    alignas(cache_line) std::atomic<std::size_t> head_{0};
+    std::size_t tail_cache_ = 0;
+    // Producer-owned line.
+    alignas(cache_line) std::atomic<std::size_t> tail_{0};
+    std::size_t head_cache_ = 0;
+    // Shared, read-only after construction.
+    alignas(cache_line) std::size_t const mask_;
+    std::unique_ptr<T[]> const slots_;
+};
+
+}  // namespace lockfree
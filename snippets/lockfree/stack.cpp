@@ -0,0 +1,64 @@
+// Treiber stack (hazard-pointer reclamation) vs a mutex-guarded std::vector.
+//
+// Each thread pushes a value and pops one per iteration.  The run fails if
+// the values popped (including the ones left over at the end) do not add up to
+// the values pushed.
+
+#include "common.hpp"
+#include "hazard_pointers.hpp"
+#include "scaling.hpp"
+#include "treiber_stack.hpp"
+
+#include <cpplearn/bench.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace {
+
+using cpplearn::bench::state;
+
+template <class Stack>
+void bm_stack(state& st) {
+    auto const threads = static_cast<unsigned>(st.arg(0));
+    Stack stack;
+    std::atomic<std::uint64_t> pushed{0};
+    std::atomic<std::uint64_t> popped{0};
+
+    st.run_threads(threads, [&](unsigned thread, std::uint64_t iterations) {
+        std::uint64_t local_pushed = 0;
+        std::uint64_t local_popped = 0;
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            std::uint64_t const value = (std::uint64_t{thread} << 40) | i;
+            stack.push(value);
+            local_pushed += value;
+            if (auto v = stack.pop()) {
+                local_popped += *v;
+            }
+        }
+        pushed.fetch_add(local_pushed, std::memory_order_relaxed);
+        popped.fetch_add(local_popped, std::memory_order_relaxed);
+    });
+
+    while (auto v = stack.pop()) {
+        popped.fetch_add(*v, std::memory_order_relaxed);
+    }
+    lockfree::hazard::reclaim();
+    if (pushed.load() != popped.load()) {
+        st.error("items lost or duplicated");
+    }
+    st.set_items_processed(st.iterations() * threads * 2);
+}
+CPPLEARN_BENCHMARK(bm_stack<lockfree::treiber_stack<std::uint64_t>>)
+    ->args_product({cpplearn::bench::thread_counts()})
+    ->arg_names({"threads"});
+CPPLEARN_BENCHMARK(bm_stack<lockfree::mutex_stack<std::uint64_t>>)
+    ->args_product({cpplearn::bench::thread_counts()})
+    ->arg_names({"threads"});
+CPPLEARN_BENCHMARK_NAMED("stress/treiber_stack", bm_stack<lockfree::treiber_stack<std::uint64_t>>)
+    ->arg(lockfree::stress_threads)
+    ->arg_names({"threads"})
+    ->iterations(lockfree::stress_iterations)
+    ->repetitions(1);
+
+}  // namespace
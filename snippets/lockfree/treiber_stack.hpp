@@ -0,0 +1,68 @@
+// Treiber's lock-free stack with hazard-pointer reclamation.
+//
+// push and pop are a single CAS on `head_`.  The classic hazards of pop are
+// reading `old->next` after another thread freed `old`, and ABA: `old` being
+// freed, reallocated and pushed again so that a stale CAS succeeds.  Holding
+// `old` in a hazard slot rules out both, because a protected node is never
+// freed and therefore never reused.
+#pragma once
+
+#include "common.hpp"
+#include "hazard_pointers.hpp"
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace lockfree {
+
+template <class T>
+class treiber_stack {
+public:
+    treiber_stack() = default;
+    treiber_stack(treiber_stack const&) = delete;
+    treiber_stack& operator=(treiber_stack const&) = delete;
+
+    ~treiber_stack() {
+        node* n = head_.load(std::memory_order_relaxed);
+        while (n) {
+            delete std::exchange(n, n->next);
+        }
+    }
+
+    void push(T value) {
+        auto* n = new node{std::move(value), head_.load(std::memory_order_relaxed)};
+        while (!head_.compare_exchange_weak(n->next, n, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::optional<T> pop() {
+        node* old;
+        for (;;) {
+            old = hazard::protect(head_);
+            if (old == nullptr) {
+                hazard::clear();
+                return std::nullopt;
+            }
+            // Safe to read: `old` is protected, so it has not been freed.
+            node* const next = old->next;
+            if (head_.compare_exchange_weak(old, next, std::memory_order_acquire, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        hazard::clear();
+        std::optional<T> value{std::move(old->value)};
+        hazard::retire(old);
+        return value;
+    }
+
+private:
+    struct node {
+        T value;
+        node* next;
+    };
+
+    alignas(cache_line) std::atomic<node*> head_{nullptr};
+};
+
+}  // namespace lockfree
@@ -0,0 +1,105 @@
+// Chase-Lev work stealing vs mutex-guarded deques on a recursive range split.
+//
+// The whole range [0, iterations) starts on worker 0's deque.  A worker takes
+// a range from its own deque (or steals one from a random victim), pushes the
+// upper half back and keeps splitting the lower half until it is at most
+// `grain` long, then processes it.  Idle workers steal, so the work spreads
+// out from worker 0 exactly as it does in a fork-join runtime.  The run fails
+// unless every index is processed exactly once.
+
+#include "chase_lev_deque.hpp"
+#include "common.hpp"
+#include "scaling.hpp"
+
+#include <cpplearn/bench.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+
+constexpr std::uint64_t grain = 64;
+
+// A range packed into one word so it fits a lock-free deque cell.
+std::uint64_t pack(std::uint64_t lo, std::uint64_t hi) {
+    return lo | (hi << 32);
+}
+
+template <template <class> class Deque>
+void bm_work_stealing(state& st) {
+    auto const threads = static_cast<unsigned>(st.arg(0));
+    std::uint64_t const n = st.iterations();
+
+    std::vector<std::unique_ptr<Deque<std::uint64_t>>> deques;
+    for (unsigned i = 0; i < threads; ++i) {
+        deques.push_back(std::make_unique<Deque<std::uint64_t>>());
+    }
+    deques[0]->push(pack(0, n));
+
+    std::atomic<std::uint64_t> remaining{n};
+    std::atomic<std::uint64_t> checksum{0};
+    std::atomic<std::uint64_t> steals{0};
+
+    st.run_threads(threads, [&](unsigned self, std::uint64_t) {
+        auto& mine = *deques[self];
+        std::uint32_t rng = self * 2654435761u + 1;
+        std::uint64_t local_sum = 0;
+        std::uint64_t local_steals = 0;
+        lockfree::backoff wait;
+
+        while (remaining.load(std::memory_order_acquire) != 0) {
+            auto task = mine.pop();
+            if (!task && threads > 1) {
+                rng ^= rng << 13, rng ^= rng >> 17, rng ^= rng << 5;
+                unsigned const victim = rng % threads;
+                if (victim != self && (task = deques[victim]->steal())) {
+                    ++local_steals;
+                }
+            }
+            if (!task) {
+                wait.pause();
+                continue;
+            }
+            wait.reset();
+
+            std::uint64_t lo = *task & 0xffff'ffff;
+            std::uint64_t hi = *task >> 32;
+            while (hi - lo > grain) {
+                std::uint64_t const mid = lo + (hi - lo) / 2;
+                mine.push(pack(mid, hi));
+                hi = mid;
+            }
+            for (std::uint64_t i = lo; i < hi; ++i) {
+                local_sum += i;
+                do_not_optimize(local_sum);
+            }
+            remaining.fetch_sub(hi - lo, std::memory_order_release);
+        }
+        checksum.fetch_add(local_sum, std::memory_order_relaxed);
+        steals.fetch_add(local_steals, std::memory_order_relaxed);
+    });
+
+    if (checksum.load() != n * (n - 1) / 2) {
+        st.error("ranges lost or processed twice");
+    }
+    st.set_items_processed(n);
+    st.set_counter("steals", static_cast<double>(steals.load()));
+}
+CPPLEARN_BENCHMARK(bm_work_stealing<lockfree::chase_lev_deque>)
+    ->args_product({cpplearn::bench::thread_counts()})
+    ->arg_names({"threads"});
+CPPLEARN_BENCHMARK(bm_work_stealing<lockfree::mutex_deque>)
+    ->args_product({cpplearn::bench::thread_counts()})
+    ->arg_names({"threads"});
+CPPLEARN_BENCHMARK_NAMED("stress/chase_lev_deque", bm_work_stealing<lockfree::chase_lev_deque>)
+    ->arg(lockfree::stress_threads)
+    ->arg_names({"threads"})
+    ->iterations(lockfree::stress_iterations * 50)
+    ->repetitions(1);
+
+}  // namespace
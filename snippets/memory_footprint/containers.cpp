@@ -0,0 +1,184 @@
+// What the standard containers really cost per element, counted on the heap.
+//
+// Each case builds one container of n elements through counting_allocator
+// and reports, per element:
+//
+//   bytes_per_element     sizeof(container) plus the malloc chunks it holds
+//                         once built: the figure to multiply by for RSS
+//   overhead_per_element  bytes_per_element minus the payload (8 bytes for
+//                         the u64 sequences, 16 for the u64 -> u64 maps, 1
+//                         per character of a string)
+//   peak_bytes_per_element  the high-water mark while building, which is
+//                         what the process needed to get there: a growing
+//                         vector holds the old and the new block at once
+//   allocs_per_element
+//
+// The small sizes show the fixed costs (a deque allocates its block map and
+// a 512-byte block for one element; a string of up to 15 characters lives in
+// the object), the large ones the asymptotic per-node price: list and map
+// nodes carry two or three pointers and a malloc header each, unordered_map
+// adds a bucket pointer per element, and vector keeps up to half its
+// capacity unused after push_back growth.
+//
+// The timed loop builds and destroys the container with std::allocator, so
+// items/s is the insertion rate that buys that footprint.
+
+#include "counting_allocator.hpp"
+
+#include <cpplearn/bench.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+namespace mf = memory_footprint;
+using u64 = std::uint64_t;
+
+template <class Alloc, class T>
+using rebind = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+
+struct vector_push {
+    static constexpr std::size_t payload = sizeof(u64);
+    template <class Alloc>
+    using type = std::vector<u64, rebind<Alloc, u64>>;
+    template <class C>
+    static void fill(C& c, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            c.push_back(i);
+        }
+    }
+};
+
+struct vector_reserved {
+    static constexpr std::size_t payload = sizeof(u64);
+    template <class Alloc>
+    using type = std::vector<u64, rebind<Alloc, u64>>;
+    template <class C>
+    static void fill(C& c, std::size_t n) {
+        c.reserve(n);
+        vector_push::fill(c, n);
+    }
+};
+
+struct deque {
+    static constexpr std::size_t payload = sizeof(u64);
+    template <class Alloc>
+    using type = std::deque<u64, rebind<Alloc, u64>>;
+    template <class C>
+    static void fill(C& c, std::size_t n) {
+        vector_push::fill(c, n);
+    }
+};
+
+struct list {
+    static constexpr std::size_t payload = sizeof(u64);
+    template <class Alloc>
+    using type = std::list<u64, rebind<Alloc, u64>>;
+    template <class C>
+    static void fill(C& c, std::size_t n) {
+        vector_push::fill(c, n);
+    }
+};
+
+struct map {
+    static constexpr std::size_t payload = 2 * sizeof(u64);
+    template <class Alloc>
+    using type = std::map<u64, u64, std::less<u64>, rebind<Alloc, std::pair<u64 const, u64>>>;
+    template <class C>
+    static void fill(C& c, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            c.emplace(i, i);
+        }
+    }
+};
+
+struct unordered_map {
+    static constexpr std::size_t payload = 2 * sizeof(u64);
+    template <class Alloc>
+    using type = std::unordered_map<u64, u64, std::hash<u64>, std::equal_to<u64>, rebind<Alloc, std::pair<u64 const, u64>>>;
+    template <class C>
+    static void fill(C& c, std::size_t n) {
+        map::fill(c, n);
+    }
+};
+
+// Appended one character at a time, so capacity grows the way it does for
+// text assembled piecewise.
+struct string {
+    static constexpr std::size_t payload = 1;
+    template <class Alloc>
+    using type = std::basic_string<char, std::char_traits<char>, rebind<Alloc, char>>;
+    template <class C>
+    static void fill(C& c, std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            c.push_back(static_cast<char>('a' + i % 26));
+        }
+    }
+};
+
+template <class Model>
+void bm_footprint(state& st) {
+    auto const n = static_cast<std::size_t>(st.arg(0));
+    using counted = typename Model::template type<mf::counting_allocator<std::byte>>;
+    using plain = typename Model::template type<std::allocator<std::byte>>;
+
+    mf::heap_usage usage;
+    mf::heap_usage built;
+    {
+        mf::usage_scope const scope{usage};
+        counted c;
+        Model::fill(c, n);
+        built = usage;
+        if (c.size() != n) {
+            st.error("container lost elements");
+            return;
+        }
+    }
+    if (usage.live_blocks != 0) {
+        st.error("blocks still allocated after the container was destroyed");
+        return;
+    }
+
+    for (auto _ : st) {
+        plain c;
+        Model::fill(c, n);
+        do_not_optimize(c.size());
+    }
+
+    auto const per_element = [n](double bytes) { return bytes / static_cast<double>(n); };
+    double const bytes = per_element(static_cast<double>(sizeof(counted) + built.live_chunk_bytes));
+    st.set_items_processed(st.iterations() * n);
+    st.set_counter("bytes_per_element", bytes);
+    st.set_counter("overhead_per_element", bytes - static_cast<double>(Model::payload));
+    st.set_counter("peak_bytes_per_element", per_element(static_cast<double>(sizeof(counted) + built.peak_chunk_bytes)));
+    st.set_counter("allocs_per_element", per_element(static_cast<double>(built.allocations)));
+    if (!mf::exact_chunks) {
+        st.set_label("requested bytes, malloc overhead not visible");
+    }
+}
+
+[[maybe_unused]] bool const registered = [] {
+    using cpplearn::bench::register_benchmark;
+    register_benchmark("footprint/vector", bm_footprint<vector_push>)->range(1, 1 << 20, 32);
+    register_benchmark("footprint/vector_reserved", bm_footprint<vector_reserved>)->range(1, 1 << 20, 32);
+    register_benchmark("footprint/deque", bm_footprint<deque>)->range(1, 1 << 20, 32);
+    register_benchmark("footprint/list", bm_footprint<list>)->range(1, 1 << 20, 32);
+    register_benchmark("footprint/map", bm_footprint<map>)->range(1, 1 << 20, 32);
+    register_benchmark("footprint/unordered_map", bm_footprint<unordered_map>)->range(1, 1 << 20, 32);
+    register_benchmark("footprint/string", bm_footprint<string>)->args_product({{1, 15, 16, 100, 1000, 1 << 20}});
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,121 @@
+// An allocator that records what a container really takes from the heap.
+//
+// Every allocation goes straight to malloc and is tallied in the heap_usage
+// of the innermost usage_scope on the calling thread (containers rebind the
+// allocator for nodes, bucket arrays and deque block maps, and all of those
+// land in the same tally).  The allocator itself is stateless, so a
+// container measured with it has the same sizeof as with std::allocator;
+// an allocator holding a pointer to its tally would add 8 bytes to every
+// container and distort exactly the small cases worth measuring.
+//
+// Besides the bytes requested it records the size of the chunk malloc set
+// aside: with glibc, malloc_usable_size() plus the 8-byte chunk header, so a
+// 1-byte request costs a 32-byte chunk and a 24-byte request fits exactly.
+// Chunk bytes are what the allocation adds to RSS once its pages are
+// touched, short of fragmentation and of memory malloc keeps cached after
+// frees.  Elsewhere chunk bytes fall back to the requested size.
+//
+// A container must be destroyed inside the scope it was filled in.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <utility>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace memory_footprint {
+
+struct heap_usage {
+    std::size_t allocations = 0;  // ever made
+    std::size_t live_blocks = 0;
+    std::size_t live_bytes = 0;  // requested
+    std::size_t live_chunk_bytes = 0;
+    std::size_t peak_chunk_bytes = 0;
+};
+
+#if defined(__GLIBC__)
+inline constexpr bool exact_chunks = true;
+#else
+inline constexpr bool exact_chunks = false;
+#endif
+
+inline std::size_t chunk_bytes([[maybe_unused]] void* ptr, [[maybe_unused]] std::size_t requested) noexcept {
+#if defined(__GLIBC__)
+    return ::malloc_usable_size(ptr) + sizeof(std::size_t);
+#else
+    return requested;
+#endif
+}
+
+// Routes this thread's counting_allocator traffic to `usage` for its
+// lifetime.  Outside any scope the counts go to a per-thread sink.
+class usage_scope {
+public:
+    explicit usage_scope(heap_usage& usage) noexcept : previous_{std::exchange(current_, &usage)} {}
+
+    usage_scope(usage_scope const&) = delete;
+    usage_scope& operator=(usage_scope const&) = delete;
+
+    ~usage_scope() { current_ = previous_; }
+
+    static heap_usage& current() noexcept {
+        thread_local heap_usage sink;
+        return current_ != nullptr ? *current_ : sink;
+    }
+
+private:
+    static inline thread_local heap_usage* current_ = nullptr;
+    heap_usage* previous_;
+};
+
+template <class T>
+class counting_allocator {
+public:
+    using value_type = T;
+
+    counting_allocator() noexcept = default;
+
+    template <class U>
+    counting_allocator(counting_allocator<U> const&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "malloc does not honour extended alignment");
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length{};
+        }
+        std::size_t const bytes = n * sizeof(T);
+        void* ptr = std::malloc(bytes);
+        if (ptr == nullptr) {
+            throw std::bad_alloc{};
+        }
+        heap_usage& usage = usage_scope::current();
+        ++usage.allocations;
+        ++usage.live_blocks;
+        usage.live_bytes += bytes;
+        usage.live_chunk_bytes += chunk_bytes(ptr, bytes);
+        usage.peak_chunk_bytes = std::max(usage.peak_chunk_bytes, usage.live_chunk_bytes);
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept {
+        std::size_t const bytes = n * sizeof(T);
+        heap_usage& usage = usage_scope::current();
+        --usage.live_blocks;
+        usage.live_bytes -= bytes;
+        usage.live_chunk_bytes -= chunk_bytes(ptr, bytes);
+        std::free(ptr);
+    }
+
+    template <class U>
+    friend bool operator==(counting_allocator const&, counting_allocator<U> const&) noexcept {
+        return true;
+    }
+};
+
+}  // namespace memory_footprint
@@ -0,0 +1,170 @@
+// std::vector vs small_vector<u32, N> (small_vector.hpp) as the element of a
+// table of 16K short sequences, lengths uniform in [0, max_len].
+//
+// seq/build/*  fills the table sequence by sequence and destroys it; items/s
+//              counts sequences.  Every non-empty std::vector allocates;
+//              small_vector allocates only for sequences longer than N.
+// seq/scan/*   sums every element of a built table.  The small_vector
+//              elements sit inside the table, read in one forward sweep;
+//              std::vector's are behind a pointer each.  Straight after a
+//              sequential build malloc has laid those blocks out in order,
+//              so the sweep barely notices; a table whose sequences were
+//              grown at different times pays the pointer chase in misses.
+//
+// Both report, from a build through counting_allocator, bytes_per_sequence
+// (table slot plus heap chunks, the RSS figure) and allocs_per_sequence.
+// The inline capacity is a footprint bet: too small and most sequences pay
+// for the inline space and a heap block, too large and every slot carries
+// unused elements.  max_len:64 is the losing end of that bet.
+
+#include "counting_allocator.hpp"
+#include "small_vector.hpp"
+
+#include <cpplearn/bench.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+namespace mf = memory_footprint;
+using u32 = std::uint32_t;
+
+constexpr std::size_t sequences = 1 << 14;
+
+template <class Alloc, class T>
+using rebind = typename std::allocator_traits<Alloc>::template rebind_alloc<T>;
+
+struct std_vector {
+    template <class Alloc>
+    using type = std::vector<u32, rebind<Alloc, u32>>;
+};
+
+template <std::size_t N>
+struct small_vector {
+    template <class Alloc>
+    using type = mf::small_vector<u32, N, rebind<Alloc, u32>>;
+};
+
+std::vector<u32> make_lengths(u32 max_len) {
+    std::mt19937 rng{31};
+    std::uniform_int_distribution<u32> length{0, max_len};
+    std::vector<u32> lengths(sequences);
+    for (auto& l : lengths) {
+        l = length(rng);
+    }
+    return lengths;
+}
+
+// Sequence i holds the next lengths[i] values of 0, 1, 2, ...
+template <class Seq, class Alloc>
+std::vector<Seq, rebind<Alloc, Seq>> build(std::span<u32 const> lengths, Alloc const& alloc) {
+    std::vector<Seq, rebind<Alloc, Seq>> table{alloc};
+    table.reserve(lengths.size());
+    u32 value = 0;
+    for (u32 const length : lengths) {
+        auto& seq = table.emplace_back(typename Seq::allocator_type{alloc});
+        for (u32 j = 0; j < length; ++j) {
+            seq.push_back(value++);
+        }
+    }
+    return table;
+}
+
+template <class Table>
+std::uint64_t sum(Table const& table) {
+    std::uint64_t total = 0;
+    for (auto const& seq : table) {
+        for (u32 const x : seq) {
+            total += x;
+        }
+    }
+    return total;
+}
+
+// Builds the table once through counting_allocator, checks it and reports
+// its footprint; false (with st.error set) if the contents are wrong.
+template <class Model>
+bool check_and_report(state& st, std::span<u32 const> lengths) {
+    using counted = mf::counting_allocator<std::byte>;
+    using seq = typename Model::template type<counted>;
+
+    std::uint64_t values = 0;
+    for (u32 const length : lengths) {
+        values += length;
+    }
+
+    mf::heap_usage usage;
+    mf::usage_scope const scope{usage};
+    auto const table = build<seq>(lengths, counted{});
+    if (sum(table) != values * (values - 1) / 2) {
+        st.error("sum of elements differs from the values stored");
+        return false;
+    }
+
+    double const n = static_cast<double>(lengths.size());
+    st.set_counter("bytes_per_sequence", static_cast<double>(sizeof(table) + usage.live_chunk_bytes) / n);
+    st.set_counter("allocs_per_sequence", static_cast<double>(usage.allocations) / n);
+    st.set_counter("sizeof", static_cast<double>(sizeof(seq)));
+    return true;
+}
+
+template <class Model>
+void bm_build(state& st) {
+    auto const lengths = make_lengths(static_cast<u32>(st.arg(0)));
+    if (!check_and_report<Model>(st, lengths)) {
+        return;
+    }
+
+    using seq = typename Model::template type<std::allocator<u32>>;
+    for (auto _ : st) {
+        auto table = build<seq>(std::span<u32 const>{lengths}, std::allocator<u32>{});
+        do_not_optimize(table.data());
+    }
+    st.set_items_processed(st.iterations() * sequences);
+}
+
+template <class Model>
+void bm_scan(state& st) {
+    auto const lengths = make_lengths(static_cast<u32>(st.arg(0)));
+    if (!check_and_report<Model>(st, lengths)) {
+        return;
+    }
+
+    using seq = typename Model::template type<std::allocator<u32>>;
+    auto const table = build<seq>(std::span<u32 const>{lengths}, std::allocator<u32>{});
+    for (auto _ : st) {
+        do_not_optimize(sum(table));
+    }
+    st.set_items_processed(st.iterations() * sequences);
+}
+
+[[maybe_unused]] bool const registered = [] {
+    using cpplearn::bench::register_benchmark;
+    struct model {
+        char const* name;
+        void (*build)(state&);
+        void (*scan)(state&);
+    };
+    for (auto const& m : {model{"std_vector", bm_build<std_vector>, bm_scan<std_vector>},
+                          model{"small_vector_4", bm_build<small_vector<4>>, bm_scan<small_vector<4>>},
+                          model{"small_vector_8", bm_build<small_vector<8>>, bm_scan<small_vector<8>>},
+                          model{"small_vector_16", bm_build<small_vector<16>>, bm_scan<small_vector<16>>}}) {
+        register_benchmark(std::string{"seq/build/"} + m.name, m.build)
+            ->args_product({{2, 4, 8, 16, 64}})
+            ->arg_names({"max_len"});
+        register_benchmark(std::string{"seq/scan/"} + m.name, m.scan)
+            ->args_product({{2, 4, 8, 16, 64}})
+            ->arg_names({"max_len"});
+    }
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,226 @@
+// small_vector<T, N>: a vector that keeps its first N elements inside the
+// object and only goes to the allocator when it outgrows them.
+//
+// For collections that are usually short (tags on a record, edges of a
+// sparse graph node, the tokens of a field) this saves the allocation, the
+// chunk header and slack malloc adds to it, and the pointer chase on every
+// access: in a std::vector of small_vectors the elements sit next to their
+// size.  The price is sizeof: N elements are reserved in every object
+// whether used or not, and once a sequence spills, its inline space is dead
+// weight on top of the heap block.  Size and capacity are 32-bit to keep the
+// header at 16 bytes, like std::vector's three pointers minus one.
+//
+// Storage comes from Allocator; elements are constructed in place with
+// placement new rather than through allocator_traits::construct.  Growth
+// doubles.  Moving a spilled vector steals its block; moving an inline one
+// moves the elements.  Move assignment takes the source's allocator along
+// with its block (propagate_on_container_move_assignment, in effect).
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace memory_footprint {
+
+template <class T, std::size_t N, class Allocator = std::allocator<T>>
+class small_vector {
+    static_assert(N > 0, "use std::vector for no inline storage");
+    static_assert(N <= std::numeric_limits<std::uint32_t>::max());
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using size32 = std::uint32_t;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = T const*;
+
+    static constexpr std::size_t inline_capacity = N;
+
+    small_vector() noexcept(std::is_nothrow_default_constructible_v<Allocator>) = default;
+    explicit small_vector(Allocator const& alloc) noexcept : alloc_{alloc} {}
+
+    small_vector(small_vector const& other)
+        : alloc_{alloc_traits::select_on_container_copy_construction(other.alloc_)} {
+        append_copy(other);
+    }
+
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : alloc_{std::move(other.alloc_)} {
+        take(other);
+    }
+
+    small_vector& operator=(small_vector const& other) {
+        if (this != &other) {
+            clear();
+            append_copy(other);
+        }
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            release();
+            alloc_ = std::move(other.alloc_);
+            take(other);
+        }
+        return *this;
+    }
+
+    ~small_vector() {
+        clear();
+        release();
+    }
+
+    template <class... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) [[unlikely]] {
+            return grow_and_emplace(std::forward<Args>(args)...);
+        }
+        T* slot = ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void push_back(T const& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() noexcept {
+        --size_;
+        std::destroy_at(data_ + size_);
+    }
+
+    void clear() noexcept {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    void reserve(size_type n) {
+        if (n > capacity_) {
+            T* block = allocate(n);
+            try {
+                relocate_to(block);
+            } catch (...) {
+                alloc_traits::deallocate(alloc_, block, n);
+                throw;
+            }
+            adopt(block, n);
+        }
+    }
+
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+    bool is_inline() const noexcept { return data_ == inline_data(); }
+
+    T* data() noexcept { return data_; }
+    T const* data() const noexcept { return data_; }
+    T& operator[](size_type i) noexcept { return data_[i]; }
+    T const& operator[](size_type i) const noexcept { return data_[i]; }
+
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+private:
+    T* inline_data() noexcept { return std::launder(reinterpret_cast<T*>(inline_)); }
+    T const* inline_data() const noexcept { return std::launder(reinterpret_cast<T const*>(inline_)); }
+
+    T* allocate(size_type n) {
+        if (n > std::numeric_limits<size32>::max()) {
+            throw std::length_error{"small_vector: more than 2^32 - 1 elements"};
+        }
+        return alloc_traits::allocate(alloc_, n);
+    }
+
+    // Destroys the old elements and switches to `block`, which already holds
+    // copies of them.
+    void adopt(T* block, size_type capacity) noexcept {
+        std::destroy(data_, data_ + size_);
+        release();
+        data_ = block;
+        capacity_ = static_cast<size32>(capacity);
+    }
+
+    void release() noexcept {
+        if (!is_inline()) {
+            alloc_traits::deallocate(alloc_, data_, capacity_);
+            data_ = inline_data();
+            capacity_ = N;
+        }
+    }
+
+    // The new element is constructed first, since `args` may refer to an
+    // element of this vector that the relocation is about to move.
+    template <class... Args>
+    T& grow_and_emplace(Args&&... args) {
+        constexpr size_type max_capacity = std::numeric_limits<size32>::max();
+        size_type const capacity = std::max(std::min(2 * size_type{capacity_}, max_capacity), size_type{size_} + 1);
+        T* block = allocate(capacity);
+        T* slot = nullptr;
+        try {
+            slot = ::new (static_cast<void*>(block + size_)) T(std::forward<Args>(args)...);
+            relocate_to(block);
+        } catch (...) {
+            if (slot != nullptr) {
+                std::destroy_at(slot);
+            }
+            alloc_traits::deallocate(alloc_, block, capacity);
+            throw;
+        }
+        adopt(block, capacity);
+        ++size_;
+        return *slot;
+    }
+
+    // Moves (or, when moving may throw, copies) the elements into `block`.
+    // If one throws, the ones already built in `block` are destroyed and
+    // *this is untouched; freeing `block` is up to the caller.
+    void relocate_to(T* block) {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move(data_, data_ + size_, block);
+        } else {
+            std::uninitialized_copy(data_, data_ + size_, block);
+        }
+    }
+
+    void append_copy(small_vector const& other) {
+        reserve(other.size_);
+        std::uninitialized_copy(other.begin(), other.end(), data_);
+        size_ = other.size_;
+    }
+
+    // Expects *this empty and inline, with other's allocator.  An inline
+    // `other` fits the inline storage, so this never allocates.
+    void take(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (!other.is_inline()) {
+            data_ = std::exchange(other.data_, other.inline_data());
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, static_cast<size32>(N));
+            return;
+        }
+        std::uninitialized_move(other.begin(), other.end(), data_);
+        size_ = other.size_;
+        other.clear();
+    }
+
+    T* data_ = inline_data();
+    size32 size_ = 0;
+    size32 capacity_ = static_cast<size32>(N);
+    alignas(T) unsigned char inline_[N * sizeof(T)];
+    [[no_unique_address]] Allocator alloc_;
+};
+
+}  // namespace memory_footprint
@@ -0,0 +1,160 @@
+// Copy elision and return value optimization.
+//
+// C++17 guarantees that returning a prvalue constructs the result directly in
+// the caller's storage (no copy, no move).  Returning a named local may be
+// elided too (NRVO), but that is an optimization, not a rule: it is lost when
+// different locals are returned on different paths, and `return std::move(x)`
+// turns it off outright.  When elision does not happen the local is moved, or
+// copied if it is const.
+
+#include "tracked.hpp"
+
+#include <cpplearn/alloc_counter.hpp>
+
+namespace {
+
+using cpplearn::bench::alloc_scope;
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+using move_semantics::payload;
+using move_semantics::tracked_counts;
+
+[[gnu::noinline]] payload make_prvalue() {
+    return payload{};
+}
+
+[[gnu::noinline]] payload make_named() {
+    payload p;
+    do_not_optimize(p);
+    return p;
+}
+
+[[gnu::noinline]] payload make_pessimized() {
+    payload p;
+    do_not_optimize(p);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpessimizing-move"
+    return std::move(p);  // disables NRVO: one extra move
+#pragma GCC diagnostic pop
+}
+
+[[gnu::noinline]] payload make_branchy(bool first) {
+    payload a;
+    payload b;
+    do_not_optimize(a);
+    do_not_optimize(b);
+    if (first) {
+        return a;  // two candidates: NRVO impossible, implicit move
+    }
+    return b;
+}
+
+[[gnu::noinline]] payload make_branchy_const(bool first) {
+    payload const a;
+    payload const b;
+    do_not_optimize(a);
+    do_not_optimize(b);
+    if (first) {
+        return a;  // const cannot be moved from: a full copy
+    }
+    return b;
+}
+
+[[gnu::noinline]] void make_out_param(payload& out) {
+    out = payload{};
+}
+
+template <class Make>
+void run_factory(state& st, Make make, bool elision_guaranteed) {
+    bool flip = false;
+    auto const before = tracked_counts;
+    alloc_scope allocs;
+    for (auto _ : st) {
+        payload p = make(flip);
+        do_not_optimize(p);
+        flip = !flip;
+    }
+    allocs.report(st);
+    auto const delta = tracked_counts - before;
+    move_semantics::report_special_members(st, delta);
+    if (elision_guaranteed && (delta.copies != 0 || delta.moves != 0)) {
+        st.error("guaranteed copy elision did not happen");
+    }
+}
+
+void bm_return_prvalue(state& st) {
+    run_factory(st, [](bool) { return make_prvalue(); }, true);
+}
+CPPLEARN_BENCHMARK(bm_return_prvalue);
+
+void bm_return_named_nrvo(state& st) {
+    run_factory(st, [](bool) { return make_named(); }, false);
+}
+CPPLEARN_BENCHMARK(bm_return_named_nrvo);
+
+void bm_return_std_move(state& st) {
+    run_factory(st, [](bool) { return make_pessimized(); }, false);
+}
+CPPLEARN_BENCHMARK(bm_return_std_move);
+
+void bm_return_branchy(state& st) {
+    run_factory(st, [](bool flip) { return make_branchy(flip); }, false);
+}
+CPPLEARN_BENCHMARK(bm_return_branchy);
+
+void bm_return_branchy_const(state& st) {
+    run_factory(st, [](bool flip) { return make_branchy_const(flip); }, false);
+}
+CPPLEARN_BENCHMARK(bm_return_branchy_const);
+
+// The pre-C++11 idiom: reuse caller storage through an out parameter.  Still
+// pays a construct + move-assign per call.
+void bm_return_out_param(state& st) {
+    payload p;
+    auto const before = tracked_counts;
+    alloc_scope allocs;
+    for (auto _ : st) {
+        make_out_param(p);
+        do_not_optimize(p);
+    }
+    allocs.report(st);
+    move_semantics::report_special_members(st, tracked_counts - before);
+}
+CPPLEARN_BENCHMARK(bm_return_out_param);
+
+// Sink parameters: a member initialised from a by-value parameter costs one
+// move for rvalue arguments and one copy + one move for lvalues; a const&
+// parameter always copies.
+struct by_value_sink {
+    explicit by_value_sink(payload p) : stored{std::move(p)} {}
+    payload stored;
+};
+
+struct by_const_ref_sink {
+    explicit by_const_ref_sink(payload const& p) : stored{p} {}
+    payload stored;
+};
+
+template <class Sink, bool Rvalue>
+void bm_sink(state& st) {
+    auto const before = tracked_counts;
+    alloc_scope allocs;
+    for (auto _ : st) {
+        payload arg;
+        if constexpr (Rvalue) {
+            Sink sink{std::move(arg)};
+            do_not_optimize(sink);
+        } else {
+            Sink sink{arg};
+            do_not_optimize(sink);
+        }
+    }
+    allocs.report(st);
+    move_semantics::report_special_members(st, tracked_counts - before);
+}
+CPPLEARN_BENCHMARK(bm_sink<by_value_sink, false>);
+CPPLEARN_BENCHMARK(bm_sink<by_value_sink, true>);
+CPPLEARN_BENCHMARK(bm_sink<by_const_ref_sink, false>);
+CPPLEARN_BENCHMARK(bm_sink<by_const_ref_sink, true>);
+
+}  // namespace
@@ -0,0 +1,108 @@
+// emplace_back vs push_back, reserve, and why move constructors should be
+// noexcept.
+//
+// push_back(T(args)) builds a temporary and moves it in; emplace_back(args)
+// builds the element in place.  For std::string the difference is a move plus
+// a destructor, never an allocation.  Growth without reserve() reallocates
+// log2(n) times, and on every reallocation std::vector moves the elements only
+// if the move constructor is noexcept; otherwise it copies them to keep the
+// strong exception guarantee.
+
+#include "tracked.hpp"
+
+#include <cpplearn/alloc_counter.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::alloc_scope;
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+using move_semantics::tracked_counts;
+
+// Long enough to defeat the small-string optimization.
+constexpr char const* long_text = "a string that is too long for the SSO buffer";
+
+enum class insert_kind { copy_lvalue, push_temporary, emplace };
+
+template <insert_kind Kind, bool Reserve>
+void bm_vector_strings(state& st) {
+    auto const n = static_cast<std::size_t>(st.arg(0));
+    std::string const source{long_text};
+    alloc_scope allocs;
+    for (auto _ : st) {
+        std::vector<std::string> v;
+        if constexpr (Reserve) {
+            v.reserve(n);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            if constexpr (Kind == insert_kind::copy_lvalue) {
+                v.push_back(source);
+            } else if constexpr (Kind == insert_kind::push_temporary) {
+                v.push_back(std::string{long_text});
+            } else {
+                v.emplace_back(long_text);
+            }
+        }
+        do_not_optimize(v.data());
+    }
+    allocs.report(st);
+    st.set_items_processed(st.iterations() * n);
+}
+CPPLEARN_BENCHMARK(bm_vector_strings<insert_kind::copy_lvalue, false>)->range(16, 4096);
+CPPLEARN_BENCHMARK(bm_vector_strings<insert_kind::push_temporary, false>)->range(16, 4096);
+CPPLEARN_BENCHMARK(bm_vector_strings<insert_kind::emplace, false>)->range(16, 4096);
+CPPLEARN_BENCHMARK(bm_vector_strings<insert_kind::emplace, true>)->range(16, 4096);
+
+// Vector growth with a noexcept and a potentially-throwing move constructor.
+template <class Payload>
+void bm_vector_growth(state& st) {
+    auto const n = static_cast<std::size_t>(st.arg(0));
+    auto const before = tracked_counts;
+    alloc_scope allocs;
+    for (auto _ : st) {
+        std::vector<Payload> v;
+        for (std::size_t i = 0; i < n; ++i) {
+            v.emplace_back(64);
+        }
+        do_not_optimize(v.data());
+    }
+    allocs.report(st);
+    move_semantics::report_special_members(st, tracked_counts - before);
+    st.set_items_processed(st.iterations() * n);
+}
+CPPLEARN_BENCHMARK(bm_vector_growth<move_semantics::payload>)->range(16, 4096);
+CPPLEARN_BENCHMARK(bm_vector_growth<move_semantics::throwing_move_payload>)->range(16, 4096);
+
+// Inserting a key that is already present: when the arguments are not a
+// ready-made key, emplace has to build the node (allocating, and constructing
+// key and value) before it can look the key up; try_emplace converts only the
+// key, looks it up, and does nothing else.
+template <bool TryEmplace>
+void bm_map_insert_existing(state& st) {
+    std::vector<std::string> keys;
+    std::map<std::string, std::string> m;
+    for (int i = 0; i < 1024; ++i) {
+        keys.push_back("key-" + std::to_string(i));
+        m.emplace(keys.back(), long_text);
+    }
+    std::size_t key = 0;
+    alloc_scope allocs;
+    for (auto _ : st) {
+        char const* k = keys[key].c_str();
+        if constexpr (TryEmplace) {
+            do_not_optimize(m.try_emplace(k, long_text));
+        } else {
+            do_not_optimize(m.emplace(k, long_text));
+        }
+        key = (key + 1) & 1023;
+    }
+    allocs.report(st);
+}
+CPPLEARN_BENCHMARK(bm_map_insert_existing<false>);
+CPPLEARN_BENCHMARK(bm_map_insert_existing<true>);
+
+}  // namespace
@@ -0,0 +1,78 @@
+// The small-string optimization.
+//
+// std::string keeps short contents inside the object itself (15 chars in
+// libstdc++, 22 in libc++), so constructing one allocates nothing.  The
+// `allocs` counter steps from 0 to 1 exactly at the implementation's limit,
+// which makes this a cheap regression check across standard library versions.
+// Moving a small string copies its bytes; moving a heap string steals a
+// pointer, so small strings are cheap to build but not free to move.
+
+#include <cpplearn/alloc_counter.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::alloc_scope;
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+
+std::size_t const sso_capacity = std::string{}.capacity();
+
+void bm_string_construct(state& st) {
+    auto const length = static_cast<std::size_t>(st.arg(0));
+    std::vector<char> const source(length, 'x');
+    alloc_scope allocs;
+    for (auto _ : st) {
+        std::string s{source.data(), length};
+        do_not_optimize(s);
+    }
+    auto const delta = allocs.delta();
+    cpplearn::bench::report_allocations(st, delta);
+    st.set_counter("sso_capacity", static_cast<double>(sso_capacity));
+
+    bool const expect_heap = length > sso_capacity;
+    bool const allocated = delta.allocations != 0;
+    if (allocated != expect_heap) {
+        st.error("allocation behavior does not match std::string capacity()");
+    }
+}
+CPPLEARN_BENCHMARK(bm_string_construct)->arg(0)->arg(8)->arg(15)->arg(16)->arg(22)->arg(23)->arg(32)->arg(128);
+
+// Two move assignments per iteration, so ns/op covers a round trip.
+void bm_string_move(state& st) {
+    auto const length = static_cast<std::size_t>(st.arg(0));
+    std::string a(length, 'x');
+    std::string b;
+    alloc_scope allocs;
+    for (auto _ : st) {
+        b = std::move(a);
+        do_not_optimize(b);
+        a = std::move(b);
+        do_not_optimize(a);
+    }
+    allocs.report(st);
+}
+CPPLEARN_BENCHMARK(bm_string_move)->arg(8)->arg(15)->arg(16)->arg(128);
+
+// Building a vector of N strings: short strings cost one allocation for the
+// vector buffer; long strings add one per element.
+void bm_vector_of_strings(state& st) {
+    auto const n = static_cast<std::size_t>(st.arg(0));
+    auto const length = static_cast<std::size_t>(st.arg(1));
+    alloc_scope allocs;
+    for (auto _ : st) {
+        std::vector<std::string> v;
+        v.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            v.emplace_back(length, 'x');
+        }
+        do_not_optimize(v.data());
+    }
+    allocs.report(st);
+    st.set_items_processed(st.iterations() * n);
+}
+CPPLEARN_BENCHMARK(bm_vector_of_strings)->args_product({{1024}, {8, 15, 16, 64}})->arg_names({"n", "len"});
+
+}  // namespace
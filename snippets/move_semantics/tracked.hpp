@@ -0,0 +1,88 @@
+// A heap-owning value type that counts its copies and moves, so snippets can
+// show which special member a language rule actually invokes.
+#pragma once
+
+#include <cpplearn/bench.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace move_semantics {
+
+struct special_member_counts {
+    std::uint64_t copies = 0;
+    std::uint64_t moves = 0;
+};
+
+// The snippets in this module are single-threaded.
+inline special_member_counts tracked_counts;
+
+inline special_member_counts operator-(special_member_counts const& a,
+                                       special_member_counts const& b) noexcept {
+    return {a.copies - b.copies, a.moves - b.moves};
+}
+
+// Copying allocates and copies `size` bytes; moving steals the buffer.  With
+// NoexceptMove = false the move constructor may throw, which makes
+// std::vector copy instead of move on reallocation.
+template <bool NoexceptMove>
+class basic_payload {
+public:
+    explicit basic_payload(std::size_t size = 256) : data_{new char[size]}, size_{size} {
+        std::memset(data_, 0x5a, size_);
+    }
+
+    basic_payload(basic_payload const& other) : data_{new char[other.size_]}, size_{other.size_} {
+        std::memcpy(data_, other.data_, size_);
+        ++tracked_counts.copies;
+    }
+
+    basic_payload(basic_payload&& other) noexcept(NoexceptMove)
+        : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)} {
+        ++tracked_counts.moves;
+    }
+
+    basic_payload& operator=(basic_payload const& other) {
+        if (this != &other) {
+            char* fresh = new char[other.size_];
+            std::memcpy(fresh, other.data_, other.size_);
+            delete[] data_;
+            data_ = fresh;
+            size_ = other.size_;
+            ++tracked_counts.copies;
+        }
+        return *this;
+    }
+
+    basic_payload& operator=(basic_payload&& other) noexcept(NoexceptMove) {
+        if (this != &other) {
+            delete[] data_;
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            ++tracked_counts.moves;
+        }
+        return *this;
+    }
+
+    ~basic_payload() { delete[] data_; }
+
+    char const* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+
+private:
+    char* data_;
+    std::size_t size_;
+};
+
+using payload = basic_payload<true>;
+using throwing_move_payload = basic_payload<false>;
+
+inline void report_special_members(cpplearn::bench::state& st, special_member_counts const& delta) {
+    using cpplearn::bench::counter_kind;
+    st.set_counter("copies", static_cast<double>(delta.copies), counter_kind::per_iteration);
+    st.set_counter("moves", static_cast<double>(delta.moves), counter_kind::per_iteration);
+}
+
+}  // namespace move_semantics
@@ -0,0 +1,301 @@
+// std::execution seq / par / par_unseq vs the work-stealing pool on for_each,
+// transform_reduce, inclusive_scan and sort, over input sizes and threads.
+//
+// One iteration is one call over `n` elements.  Every parallel variant also
+// reports `speedup` against the seq policy on the same input, measured once per
+// algorithm and size outside the timed region, so the crossover where a
+// parallel policy starts (or stops) paying off can be read straight off the
+// report.
+//
+// With TBB found at configure time, libstdc++ runs par and par_unseq on TBB and
+// `threads` caps TBB through tbb::global_control.  Without it libstdc++ falls
+// back to running them sequentially; the label says which backend was used.
+
+#include "pool_algorithms.hpp"
+#include "thread_pool.hpp"
+
+#include <cpplearn/bench.hpp>
+
+#if CPPLEARN_HAVE_TBB
+#include <tbb/global_control.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+
+enum class variant { seq, par, par_unseq, pool };
+
+// Runs `f` with the execution policy object for `V`.
+template <variant V, class F>
+decltype(auto) with_policy(F&& f) {
+    if constexpr (V == variant::seq) {
+        return f(std::execution::seq);
+    } else if constexpr (V == variant::par) {
+        return f(std::execution::par);
+    } else {
+        return f(std::execution::par_unseq);
+    }
+}
+
+// Everything a variant needs for `threads`: a TBB concurrency cap for the
+// standard policies, a pool for the hand-rolled one.
+template <variant V>
+class context {
+public:
+    explicit context(unsigned threads) {
+        if constexpr (V == variant::pool) {
+            pool_ = std::make_unique<parallel::thread_pool>(threads);
+        }
+#if CPPLEARN_HAVE_TBB
+        else {
+            limit_ = std::make_unique<tbb::global_control>(tbb::global_control::max_allowed_parallelism, threads);
+        }
+#endif
+    }
+
+    parallel::thread_pool& pool() { return *pool_; }
+
+    static char const* label() {
+        if constexpr (V == variant::pool) {
+            return "work-stealing pool";
+        } else if constexpr (V == variant::seq) {
+            return "seq";
+        } else {
+            return CPPLEARN_HAVE_TBB ? "TBB backend" : "serial backend (no TBB)";
+        }
+    }
+
+private:
+    std::unique_ptr<parallel::thread_pool> pool_;
+#if CPPLEARN_HAVE_TBB
+    std::unique_ptr<tbb::global_control> limit_;
+#endif
+};
+
+std::vector<std::uint32_t> random_values(std::size_t n, std::uint32_t max, unsigned seed = 42) {
+    std::mt19937 rng{seed};
+    std::uniform_int_distribution<std::uint32_t> dist{0, max};
+    std::vector<std::uint32_t> v(n);
+    for (auto& x : v) {
+        x = dist(rng);
+    }
+    return v;
+}
+
+// Seconds per call of `run`: best of a few runs, cached per key.  `run` may
+// make `calls` calls at once.
+double seq_seconds(std::string const& key, std::function<void()> const& run, std::size_t calls) {
+    static std::map<std::string, double> cache;
+    if (auto it = cache.find(key); it != cache.end()) {
+        return it->second;
+    }
+    double best = 1e30;
+    for (int i = 0; i < 5; ++i) {
+        auto const start = std::chrono::steady_clock::now();
+        run();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return cache[key] = best / static_cast<double>(calls);
+}
+
+template <variant V>
+void finish(state& st, std::size_t n, std::string const& algorithm, std::function<void()> const& seq_run,
+            std::size_t seq_calls = 1) {
+    st.set_items_processed(st.iterations() * n);
+    st.set_label(context<V>::label());
+    if constexpr (V != variant::seq) {
+        double const baseline = seq_seconds(algorithm + "/" + std::to_string(n), seq_run, seq_calls);
+        double const per_call = st.elapsed_seconds() / static_cast<double>(st.iterations());
+        st.set_counter("speedup", baseline / per_call);
+    }
+}
+
+// A few multiplies per element, so the loop is not purely memory bound.
+std::uint32_t mix(std::uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352d;
+    x ^= x >> 15;
+    x *= 0x846ca68b;
+    return x ^ (x >> 16);
+}
+
+template <variant V>
+void bm_for_each(state& st) {
+    auto const n = static_cast<std::size_t>(st.arg(0));
+    context<V> ctx{static_cast<unsigned>(st.arg(1))};
+    auto data = random_values(n, ~0u);
+    auto const f = [](std::uint32_t& x) { x = mix(x); };
+    auto const run = [&](std::vector<std::uint32_t>& values) {
+        if constexpr (V == variant::pool) {
+            parallel::pool_for_each(ctx.pool(), std::span{values}, f);
+        } else {
+            with_policy<V>([&](auto const& policy) { std::for_each(policy, values.begin(), values.end(), f); });
+        }
+    };
+
+    // Checked once on a copy; replaying every timed iteration sequentially
+    // would cost as much as the runs themselves.
+    auto checked = data;
+    auto expected = data;
+    run(checked);
+    std::for_each(expected.begin(), expected.end(), f);
+    if (checked != expected) {
+        st.error("result differs from sequential for_each");
+        return;
+    }
+
+    for (auto _ : st) {
+        run(data);
+        do_not_optimize(data.data());
+    }
+
+    auto scratch = random_values(n, ~0u);
+    finish<V>(st, n, "for_each", [&] { std::for_each(std::execution::seq, scratch.begin(), scratch.end(), f); });
+}
+
+template <variant V>
+void bm_transform_reduce(state& st) {
+    auto const n = static_cast<std::size_t>(st.arg(0));
+    context<V> ctx{static_cast<unsigned>(st.arg(1))};
+    auto const data = random_values(n, 1u << 20);
+    auto const square = [](std::uint32_t x) { return std::uint64_t{x} * x; };
+    auto const run_seq = [&] {
+        return std::transform_reduce(std::execution::seq, data.begin(), data.end(), std::uint64_t{0},
+                                     std::plus<>{}, square);
+    };
+
+    std::uint64_t sum = 0;
+    for (auto _ : st) {
+        if constexpr (V == variant::pool) {
+            sum = parallel::pool_transform_reduce(ctx.pool(), std::span{data}, std::uint64_t{0}, std::plus<>{},
+                                                  square);
+        } else {
+            sum = with_policy<V>([&](auto const& policy) {
+                return std::transform_reduce(policy, data.begin(), data.end(), std::uint64_t{0}, std::plus<>{},
+                                             square);
+            });
+        }
+        do_not_optimize(sum);
+    }
+
+    if (sum != run_seq()) {
+        st.error("result differs from sequential transform_reduce");
+    }
+    finish<V>(st, n, "transform_reduce", [&] { do_not_optimize(run_seq()); });
+}
+
+template <variant V>
+void bm_inclusive_scan(state& st) {
+    auto const n = static_cast<std::size_t>(st.arg(0));
+    context<V> ctx{static_cast<unsigned>(st.arg(1))};
+    auto const values = random_values(n, 1000);
+    std::vector<std::uint64_t> const in(values.begin(), values.end());
+    std::vector<std::uint64_t> out(n);
+
+    for (auto _ : st) {
+        if constexpr (V == variant::pool) {
+            parallel::pool_inclusive_scan(ctx.pool(), std::span{in}, std::span{out});
+        } else {
+            with_policy<V>([&](auto const& policy) { std::inclusive_scan(policy, in.begin(), in.end(), out.begin()); });
+        }
+        do_not_optimize(out.data());
+    }
+
+    std::vector<std::uint64_t> expected(n);
+    auto const run_seq = [&] { std::inclusive_scan(std::execution::seq, in.begin(), in.end(), expected.begin()); };
+    run_seq();
+    if (out != expected) {
+        st.error("result differs from sequential inclusive_scan");
+    }
+    finish<V>(st, n, "inclusive_scan", run_seq);
+}
+
+// The copy of the unsorted input is part of every iteration, for every
+// variant, and is done sequentially.  Small sizes cycle through several
+// inputs: sorting the same 1024 keys over and over lets the branch predictor
+// learn them, and std::sort then runs several times faster than it would on
+// fresh data.
+template <variant V>
+void bm_sort(state& st) {
+    auto const n = static_cast<std::size_t>(st.arg(0));
+    context<V> ctx{static_cast<unsigned>(st.arg(1))};
+    std::vector<std::vector<std::uint32_t>> inputs(std::max<std::size_t>(1, (std::size_t{1} << 18) / n));
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        inputs[i] = random_values(n, ~0u, static_cast<unsigned>(i));
+    }
+    std::vector<std::uint32_t> data(n);
+    std::vector<std::uint32_t> scratch(n);
+
+    std::size_t next = 0;
+    for (auto _ : st) {
+        auto const& input = inputs[next];
+        next = next + 1 == inputs.size() ? 0 : next + 1;
+        std::copy(input.begin(), input.end(), data.begin());
+        if constexpr (V == variant::pool) {
+            parallel::pool_sort(ctx.pool(), std::span{data}, std::span{scratch});
+        } else {
+            with_policy<V>([&](auto const& policy) { std::sort(policy, data.begin(), data.end()); });
+        }
+        do_not_optimize(data.data());
+    }
+
+    auto expected = inputs[(next + inputs.size() - 1) % inputs.size()];
+    std::sort(expected.begin(), expected.end());
+    if (data != expected) {
+        st.error("result differs from sequential sort");
+    }
+    std::size_t baseline_next = 0;
+    finish<V>(st, n, "sort", [&] {
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            auto const& input = inputs[baseline_next];
+            baseline_next = baseline_next + 1 == inputs.size() ? 0 : baseline_next + 1;
+            std::copy(input.begin(), input.end(), scratch.begin());
+            std::sort(std::execution::seq, scratch.begin(), scratch.end());
+        }
+    }, inputs.size());
+}
+
+std::vector<std::int64_t> const sizes = {1 << 10, 1 << 13, 1 << 16, 1 << 19, 1 << 22};
+
+using bench_fn = void (*)(state&);
+
+void register_algorithm(std::string const& algorithm, bench_fn seq, bench_fn par, bench_fn par_unseq, bench_fn pool) {
+    std::pair<char const*, bench_fn> const variants[] = {
+        {"seq", seq}, {"par", par}, {"par_unseq", par_unseq}, {"pool", pool}};
+    for (auto const& [suffix, fn] : variants) {
+        auto const threads = fn == seq ? std::vector<std::int64_t>{1} : cpplearn::bench::thread_counts();
+        cpplearn::bench::register_benchmark(algorithm + "/" + suffix, fn)
+            ->args_product({sizes, threads})
+            ->arg_names({"n", "threads"});
+    }
+}
+
+[[maybe_unused]] bool const registered = [] {
+    register_algorithm("for_each", bm_for_each<variant::seq>, bm_for_each<variant::par>,
+                       bm_for_each<variant::par_unseq>, bm_for_each<variant::pool>);
+    register_algorithm("transform_reduce", bm_transform_reduce<variant::seq>, bm_transform_reduce<variant::par>,
+                       bm_transform_reduce<variant::par_unseq>, bm_transform_reduce<variant::pool>);
+    register_algorithm("inclusive_scan", bm_inclusive_scan<variant::seq>, bm_inclusive_scan<variant::par>,
+                       bm_inclusive_scan<variant::par_unseq>, bm_inclusive_scan<variant::pool>);
+    register_algorithm("sort", bm_sort<variant::seq>, bm_sort<variant::par>, bm_sort<variant::par_unseq>,
+                       bm_sort<variant::pool>);
+    return true;
+}();
+
+}  // namespace
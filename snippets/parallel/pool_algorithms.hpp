@@ -0,0 +1,113 @@
+// for_each, transform_reduce, inclusive_scan and sort on thread_pool, shaped
+// like the standard algorithms they are compared with.
+//
+// They are the textbook decompositions: for_each and transform_reduce are one
+// parallel_for (with per-worker partial results), inclusive_scan is the
+// two-pass blocked scan, and sort sorts chunks in parallel and then merges
+// pairs in rounds.  The last merge round is a single sequential merge of the
+// whole array, which caps how far the pool sort can scale.
+#pragma once
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace parallel {
+
+// Each range handed to a body is at least this long, so per-range overhead
+// (a few deque operations) stays small against the work in it.
+inline constexpr std::size_t default_grain = 2048;
+
+template <class T, class F>
+void pool_for_each(thread_pool& pool, std::span<T> data, F f) {
+    pool.parallel_for(data.size(), default_grain, [&](std::size_t lo, std::size_t hi, unsigned) {
+        std::for_each(data.begin() + lo, data.begin() + hi, f);
+    });
+}
+
+// T{} must be the identity of `reduce`.
+template <class T, class U, class Reduce, class Transform>
+T pool_transform_reduce(thread_pool& pool, std::span<U const> data, T init, Reduce reduce,
+                        Transform transform) {
+    struct alignas(lockfree::cache_line) partial {
+        T value{};
+    };
+    std::vector<partial> partials(pool.size());
+    pool.parallel_for(data.size(), default_grain, [&](std::size_t lo, std::size_t hi, unsigned worker) {
+        partials[worker].value = std::transform_reduce(data.begin() + lo, data.begin() + hi,
+                                                       partials[worker].value, reduce, transform);
+    });
+    for (auto const& p : partials) {
+        init = reduce(init, p.value);
+    }
+    return init;
+}
+
+template <class T>
+void pool_inclusive_scan(thread_pool& pool, std::span<T const> in, std::span<T> out) {
+    std::size_t const n = in.size();
+    std::size_t const blocks = std::clamp<std::size_t>(n / default_grain, 1, pool.size() * 8);
+    std::size_t const block = (n + blocks - 1) / blocks;
+    std::vector<T> offsets(blocks + 1, T{});
+
+    pool.parallel_for(blocks, 1, [&](std::size_t lo, std::size_t hi, unsigned) {
+        for (std::size_t b = lo; b < hi; ++b) {
+            std::size_t const first = std::min(b * block, n);
+            std::size_t const last = std::min(first + block, n);
+            offsets[b + 1] = std::reduce(in.begin() + first, in.begin() + last, T{});
+        }
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    pool.parallel_for(blocks, 1, [&](std::size_t lo, std::size_t hi, unsigned) {
+        for (std::size_t b = lo; b < hi; ++b) {
+            std::size_t const first = std::min(b * block, n);
+            std::size_t const last = std::min(first + block, n);
+            std::inclusive_scan(in.begin() + first, in.begin() + last, out.begin() + first, std::plus<>{},
+                                offsets[b]);
+        }
+    });
+}
+
+// `scratch` must be as large as `data`.
+template <class T>
+void pool_sort(thread_pool& pool, std::span<T> data, std::span<T> scratch) {
+    std::size_t const n = data.size();
+    std::size_t chunks = 1;
+    while (chunks < pool.size() * 4 && n / (chunks * 2) >= default_grain) {
+        chunks *= 2;
+    }
+    std::size_t const chunk = (n + chunks - 1) / chunks;
+    auto bounds = [&](std::size_t i) { return std::min(i * chunk, n); };
+
+    pool.parallel_for(chunks, 1, [&](std::size_t lo, std::size_t hi, unsigned) {
+        for (std::size_t c = lo; c < hi; ++c) {
+            std::sort(data.begin() + bounds(c), data.begin() + bounds(c + 1));
+        }
+    });
+
+    std::span<T> src = data;
+    std::span<T> dst = scratch;
+    for (std::size_t width = 1; width < chunks; width *= 2) {
+        pool.parallel_for(chunks / (width * 2), 1, [&](std::size_t lo, std::size_t hi, unsigned) {
+            for (std::size_t pair = lo; pair < hi; ++pair) {
+                std::size_t const first = bounds(pair * width * 2);
+                std::size_t const mid = bounds(pair * width * 2 + width);
+                std::size_t const last = bounds(pair * width * 2 + width * 2);
+                std::merge(src.begin() + first, src.begin() + mid, src.begin() + mid, src.begin() + last,
+                           dst.begin() + first);
+            }
+        });
+        std::swap(src, dst);
+    }
+    if (src.data() != data.data()) {
+        pool.parallel_for(n, default_grain * 8, [&](std::size_t lo, std::size_t hi, unsigned) {
+            std::copy(src.begin() + lo, src.begin() + hi, data.begin() + lo);
+        });
+    }
+}
+
+}  // namespace parallel
@@ -0,0 +1,116 @@
+#include "thread_pool.hpp"
+
+#include <cpplearn/bench.hpp>
+#include <cpplearn/trace.hpp>
+
+#include <stdexcept>
+
+namespace parallel {
+
+namespace {
+
+std::uint64_t pack(std::size_t lo, std::size_t hi) {
+    return static_cast<std::uint64_t>(lo) | (static_cast<std::uint64_t>(hi) << 32);
+}
+
+}  // namespace
+
+thread_pool::thread_pool(unsigned threads) {
+    if (threads == 0) {
+        threads = 1;
+    }
+    for (unsigned i = 0; i < threads; ++i) {
+        deques_.push_back(std::make_unique<lockfree::chase_lev_deque<std::uint64_t>>());
+    }
+    for (unsigned i = 1; i < threads; ++i) {
+        workers_.emplace_back([this, i] {
+            cpplearn::bench::pin_current_thread(cpplearn::bench::worker_cpu(i));
+            worker_loop(i);
+        });
+    }
+}
+
+thread_pool::~thread_pool() {
+    stop_.store(true, std::memory_order_relaxed);
+    epoch_.fetch_add(1, std::memory_order_release);
+    epoch_.notify_all();
+    for (auto& w : workers_) {
+        w.join();
+    }
+}
+
+void thread_pool::run(std::size_t n, std::size_t grain, invoke_fn invoke, void* ctx) {
+    if (n == 0) {
+        return;
+    }
+    if (n > 0xffff'ffff) {
+        throw std::length_error{"thread_pool::parallel_for: range too large"};
+    }
+    invoke_ = invoke;
+    ctx_ = ctx;
+    grain_ = grain == 0 ? 1 : grain;
+    remaining_.store(n, std::memory_order_relaxed);
+    deques_[0]->push(pack(0, n));
+    epoch_.fetch_add(1, std::memory_order_release);
+    epoch_.notify_all();
+
+    std::uint32_t rng = 1;
+    lockfree::backoff wait;
+    while (remaining_.load(std::memory_order_acquire) != 0) {
+        if (try_work(0, rng)) {
+            wait.reset();
+        } else {
+            wait.pause();
+        }
+    }
+}
+
+void thread_pool::worker_loop(unsigned self) {
+    std::uint32_t rng = self * 2654435761u + 1;
+    std::uint64_t seen = 0;
+    for (;;) {
+        epoch_.wait(seen, std::memory_order_acquire);
+        seen = epoch_.load(std::memory_order_acquire);
+        if (stop_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        lockfree::backoff wait;
+        while (remaining_.load(std::memory_order_acquire) != 0) {
+            if (try_work(self, rng)) {
+                wait.reset();
+            } else {
+                wait.pause();
+            }
+        }
+    }
+}
+
+bool thread_pool::try_work(unsigned self, std::uint32_t& rng) {
+    auto task = deques_[self]->pop();
+    if (!task && deques_.size() > 1) {
+        rng ^= rng << 13, rng ^= rng >> 17, rng ^= rng << 5;
+        auto const victim = static_cast<unsigned>(rng % deques_.size());
+        if (victim != self) {
+            task = deques_[victim]->steal();
+        }
+    }
+    if (!task) {
+        return false;
+    }
+
+    std::size_t lo = *task & 0xffff'ffff;
+    std::size_t hi = *task >> 32;
+    while (hi - lo > grain_) {
+        std::size_t const mid = lo + (hi - lo) / 2;
+        deques_[self]->push(pack(mid, hi));
+        hi = mid;
+    }
+    {
+        CPPLEARN_TRACE_SCOPE("chunk");
+        invoke_(ctx_, lo, hi, self);
+    }
+    remaining_.fetch_sub(hi - lo, std::memory_order_acq_rel);
+    return true;
+}
+
+}  // namespace parallel
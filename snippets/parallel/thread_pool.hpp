@@ -0,0 +1,68 @@
+// A fork-join thread pool with per-worker Chase-Lev deques.
+//
+// parallel_for puts the whole range on the calling thread's deque.  Whoever
+// takes a range splits it in half repeatedly, pushing the upper halves onto
+// its own deque, until the piece is at most `grain` long, then runs it.  Idle
+// workers steal from random victims, taking the oldest (largest) ranges
+// first, so the work spreads in O(log n) steals and load imbalance between
+// pieces evens out on its own.  The calling thread works too and counts as
+// worker 0.
+//
+// Jobs run one at a time and only the thread that created the pool may call
+// parallel_for; bodies must not throw or call back into the pool.  Ranges are packed
+// into one 64-bit deque cell, which limits n to 2^32 - 1.
+#pragma once
+
+#include "lockfree/chase_lev_deque.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace parallel {
+
+class thread_pool {
+public:
+    // `threads` counts the calling thread: thread_pool{1} starts no workers.
+    explicit thread_pool(unsigned threads);
+    ~thread_pool();
+    thread_pool(thread_pool const&) = delete;
+    thread_pool& operator=(thread_pool const&) = delete;
+
+    unsigned size() const noexcept { return static_cast<unsigned>(deques_.size()); }
+
+    // Calls body(lo, hi, worker) for disjoint ranges covering [0, n) and
+    // returns when all of them have run.  `worker` is in [0, size()).
+    template <class Body>
+    void parallel_for(std::size_t n, std::size_t grain, Body&& body) {
+        run(n, grain, [](void* ctx, std::size_t lo, std::size_t hi, unsigned worker) {
+            (*static_cast<std::remove_reference_t<Body>*>(ctx))(lo, hi, worker);
+        }, &body);
+    }
+
+private:
+    using invoke_fn = void (*)(void*, std::size_t, std::size_t, unsigned);
+
+    void run(std::size_t n, std::size_t grain, invoke_fn invoke, void* ctx);
+    void worker_loop(unsigned self);
+    bool try_work(unsigned self, std::uint32_t& rng);
+
+    std::vector<std::unique_ptr<lockfree::chase_lev_deque<std::uint64_t>>> deques_;
+    std::vector<std::thread> workers_;
+
+    // The current job.  Written by the caller before the root range is
+    // pushed, read by workers only after they took a range of that job.
+    invoke_fn invoke_ = nullptr;
+    void* ctx_ = nullptr;
+    std::size_t grain_ = 1;
+
+    alignas(lockfree::cache_line) std::atomic<std::size_t> remaining_{0};
+    alignas(lockfree::cache_line) std::atomic<std::uint64_t> epoch_{0};
+    std::atomic<bool> stop_{false};
+};
+
+}  // namespace parallel
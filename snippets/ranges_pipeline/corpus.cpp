@@ -0,0 +1,25 @@
+#include "pipelines.hpp"
+
+#include <random>
+
+namespace pipeline {
+
+std::string make_corpus(std::size_t bytes) {
+    std::mt19937 rng{17};
+    std::string text;
+    text.reserve(bytes + 64);
+    while (text.size() < bytes) {
+        // 2..10 letters, or 16..30 for one word in ten; first letter upper
+        // case one time in four.
+        std::size_t const length = rng() % 10 == 0 ? 16 + rng() % 15 : 2 + rng() % 9;
+        for (std::size_t i = 0; i < length; ++i) {
+            char const base = i == 0 && rng() % 4 == 0 ? 'A' : 'a';
+            text += static_cast<char>(base + rng() % 26);
+        }
+        text += ' ';
+    }
+    text.pop_back();
+    return text;
+}
+
+}  // namespace pipeline
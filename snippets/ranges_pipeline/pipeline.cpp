@@ -0,0 +1,53 @@
+// The pipeline of pipelines.hpp, eager vs lazy, on `kib` KiB of text.
+//
+// Every variant must produce the same summary as hand_loop.  `allocs` and
+// `alloc_bytes` are per pass over the text: eager_strings pays one vector per
+// stage plus one heap string per long token at each of its three stages;
+// eager_views only the vectors and the lowercased buffer; lazy_views nothing.
+// What remains between lazy_views and hand_loop is mostly the tokenizer:
+// views::split compares one character at a time, string_view::find uses
+// memchr.
+
+#include "pipelines.hpp"
+
+#include <cpplearn/alloc_counter.hpp>
+#include <cpplearn/bench.hpp>
+
+#include <string>
+
+namespace {
+
+using cpplearn::bench::alloc_scope;
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+
+template <pipeline::summary (*Variant)(std::string_view)>
+void bm_pipeline(state& st) {
+    std::string const text = pipeline::make_corpus(static_cast<std::size_t>(st.arg(0)) << 10);
+    pipeline::summary const expected = pipeline::hand_loop(text);
+    if (Variant(text) != expected) {
+        st.error("summary differs from hand_loop");
+        return;
+    }
+    alloc_scope allocs;
+    for (auto _ : st) {
+        do_not_optimize(Variant(text));
+    }
+    allocs.report(st);
+    st.set_items_processed(st.iterations() * expected.words);
+    st.set_bytes_processed(st.iterations() * text.size());
+}
+CPPLEARN_BENCHMARK_NAMED("pipeline/eager_strings", bm_pipeline<pipeline::eager_strings>)
+    ->args_product({{64, 4096}})
+    ->arg_names({"kib"});
+CPPLEARN_BENCHMARK_NAMED("pipeline/eager_views", bm_pipeline<pipeline::eager_views>)
+    ->args_product({{64, 4096}})
+    ->arg_names({"kib"});
+CPPLEARN_BENCHMARK_NAMED("pipeline/lazy_views", bm_pipeline<pipeline::lazy_views>)
+    ->args_product({{64, 4096}})
+    ->arg_names({"kib"});
+CPPLEARN_BENCHMARK_NAMED("pipeline/hand_loop", bm_pipeline<pipeline::hand_loop>)
+    ->args_product({{64, 4096}})
+    ->arg_names({"kib"});
+
+}  // namespace
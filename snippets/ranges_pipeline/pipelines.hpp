@@ -0,0 +1,156 @@
+// One text pipeline, written four ways.
+//
+//   tokenize   split on spaces
+//   filter     keep words of at least `min_length` characters
+//   transform  lowercase
+//   aggregate  count words and characters, hash the lowercased text
+//
+// eager_strings  every stage materializes a std::vector<std::string>
+// eager_views    tokens and survivors are string_views into the input; the
+//                lowercased words go into one shared buffer
+// lazy_views     std::views::split | transform | filter, lowercased on the fly
+//                by a transform view while aggregating: no intermediate storage
+// hand_loop      one pass, no ranges, for reference
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace pipeline {
+
+inline constexpr std::size_t min_length = 4;
+
+struct summary {
+    std::size_t words = 0;
+    std::size_t chars = 0;
+    std::uint64_t checksum = 14695981039346656037ull;  // FNV-1a over the words, each followed by ' '
+
+    void add(char c) noexcept {
+        checksum = (checksum ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+
+    friend bool operator==(summary const&, summary const&) = default;
+};
+
+inline char to_lower(char c) noexcept {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+inline bool keep(std::string_view word) noexcept {
+    return word.size() >= min_length;
+}
+
+// Mixed-case words separated by single spaces, about one in ten longer than
+// the small-string buffer.  Deterministic for a given size.
+std::string make_corpus(std::size_t bytes);
+
+// The non-empty space-separated tokens, as views into `text`.
+inline std::vector<std::string_view> split_words(std::string_view text) {
+    std::vector<std::string_view> words;
+    std::size_t start = 0;
+    while (start < text.size()) {
+        std::size_t end = text.find(' ', start);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        if (end > start) {
+            words.push_back(text.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+    return words;
+}
+
+inline summary eager_strings(std::string_view text) {
+    std::vector<std::string> tokens;
+    for (std::string_view word : split_words(text)) {
+        tokens.emplace_back(word);
+    }
+    std::vector<std::string> kept;
+    std::copy_if(tokens.begin(), tokens.end(), std::back_inserter(kept),
+                 [](std::string const& w) { return keep(w); });
+    std::vector<std::string> lowered;
+    for (std::string const& w : kept) {
+        std::string l = w;
+        std::transform(l.begin(), l.end(), l.begin(), to_lower);
+        lowered.push_back(std::move(l));
+    }
+    summary s;
+    for (std::string const& w : lowered) {
+        ++s.words;
+        s.chars += w.size();
+        for (char c : w) {
+            s.add(c);
+        }
+        s.add(' ');
+    }
+    return s;
+}
+
+inline summary eager_views(std::string_view text) {
+    std::vector<std::string_view> tokens = split_words(text);
+    std::vector<std::string_view> kept;
+    std::copy_if(tokens.begin(), tokens.end(), std::back_inserter(kept), keep);
+    std::string lowered;
+    for (std::string_view w : kept) {
+        std::transform(w.begin(), w.end(), std::back_inserter(lowered), to_lower);
+        lowered += ' ';
+    }
+    summary s;
+    s.words = kept.size();
+    s.chars = lowered.size() - kept.size();
+    for (char c : lowered) {
+        s.add(c);
+    }
+    return s;
+}
+
+// The lazy word sequence, shared with the pitfall cases.
+inline auto lazy_words(std::string_view text) {
+    return text | std::views::split(' ')
+           | std::views::transform([](auto&& r) { return std::string_view(r.begin(), r.end()); })
+           | std::views::filter([](std::string_view w) { return !w.empty(); });
+}
+
+inline summary lazy_views(std::string_view text) {
+    summary s;
+    for (std::string_view w : lazy_words(text) | std::views::filter(keep)) {
+        ++s.words;
+        s.chars += w.size();
+        for (char c : w | std::views::transform(to_lower)) {
+            s.add(c);
+        }
+        s.add(' ');
+    }
+    return s;
+}
+
+inline summary hand_loop(std::string_view text) {
+    summary s;
+    std::size_t start = 0;
+    while (start < text.size()) {
+        std::size_t end = text.find(' ', start);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        if (end - start >= min_length) {
+            ++s.words;
+            s.chars += end - start;
+            for (std::size_t i = start; i < end; ++i) {
+                s.add(to_lower(text[i]));
+            }
+            s.add(' ');
+        }
+        start = end + 1;
+    }
+    return s;
+}
+
+}  // namespace pipeline
@@ -0,0 +1,259 @@
+// Where lazy views lose to materializing once.
+//
+// transform_then_filter  `transform(f) | filter(p)` calls f once for the
+//                        filter's test and again when the loop dereferences
+//                        an element that passed, so survivors pay f twice;
+//                        `calls_per_word` shows it.  Filtering first, or
+//                        storing f's results, calls f once.
+// repeated_traversal     a view is a recipe, not a result: each of `passes`
+//                        statistics over `lazy_words | filter` re-splits the
+//                        whole text, where the eager version splits once into
+//                        a vector and re-reads that.
+// first_match            filter_view::begin() scans to the first match and
+//                        caches it in the view object.  A helper returning a
+//                        fresh `words | filter(p)` rescans on every call; a
+//                        view (or iterator) kept across calls scans once.
+// nth_match              filter_view is only bidirectional: reaching the i-th
+//                        survivor walks from begin() every time, where a
+//                        vector of survivors indexes in O(1), even counting
+//                        the time to build it.
+//
+// Every case checks that both variants agree.
+
+#include "pipelines.hpp"
+
+#include <cpplearn/bench.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+using pipeline::summary;
+
+std::string const& corpus() {
+    static std::string const text = pipeline::make_corpus(std::size_t{256} << 10);
+    return text;
+}
+
+std::vector<std::string_view> const& corpus_words() {
+    static std::vector<std::string_view> const words = pipeline::split_words(corpus());
+    return words;
+}
+
+// --- transform, then filter ------------------------------------------------
+
+std::uint64_t normalize_calls = 0;
+
+// Stands in for an expensive per-word transform: hashes the lowercased word.
+std::uint64_t normalize(std::string_view w) {
+    ++normalize_calls;
+    summary s;
+    for (char c : w) {
+        s.add(pipeline::to_lower(c));
+    }
+    return s.checksum;
+}
+
+bool interesting(std::uint64_t h) {
+    return h % 4 != 0;
+}
+
+std::uint64_t sum_lazy(std::vector<std::string_view> const& words) {
+    std::uint64_t sum = 0;
+    for (std::uint64_t h : words | std::views::transform(normalize) | std::views::filter(interesting)) {
+        sum += h;
+    }
+    return sum;
+}
+
+std::uint64_t sum_eager(std::vector<std::string_view> const& words) {
+    std::vector<std::uint64_t> hashes(words.size());
+    std::ranges::transform(words, hashes.begin(), normalize);
+    std::uint64_t sum = 0;
+    for (std::uint64_t h : hashes) {
+        sum += interesting(h) ? h : 0;
+    }
+    return sum;
+}
+
+template <std::uint64_t (*Sum)(std::vector<std::string_view> const&)>
+void bm_transform_then_filter(state& st) {
+    auto const& words = corpus_words();
+    if (sum_lazy(words) != sum_eager(words)) {
+        st.error("lazy and eager sums differ");
+        return;
+    }
+    normalize_calls = 0;
+    for (auto _ : st) {
+        do_not_optimize(Sum(words));
+    }
+    st.set_items_processed(st.iterations() * words.size());
+    st.set_counter("calls_per_word", static_cast<double>(normalize_calls) /
+                                         static_cast<double>(st.iterations() * words.size()));
+}
+CPPLEARN_BENCHMARK_NAMED("transform_then_filter/lazy", bm_transform_then_filter<sum_lazy>);
+CPPLEARN_BENCHMARK_NAMED("transform_then_filter/eager", bm_transform_then_filter<sum_eager>);
+
+// --- several passes over one pipeline --------------------------------------
+
+// Pass i computes statistic i % 4 over the kept words.
+template <class Words>
+std::uint64_t statistic(Words&& words, int which) {
+    std::uint64_t r = 0;
+    for (std::string_view w : words) {
+        switch (which) {
+        case 0: ++r; break;
+        case 1: r += w.size(); break;
+        case 2: r = std::max<std::uint64_t>(r, w.size()); break;
+        default: r = r * 31 + static_cast<unsigned char>(w[0]); break;
+        }
+    }
+    return r;
+}
+
+std::uint64_t passes_lazy(std::string_view text, int passes) {
+    std::uint64_t r = 0;
+    for (int p = 0; p < passes; ++p) {
+        r += statistic(pipeline::lazy_words(text) | std::views::filter(pipeline::keep), p % 4);
+    }
+    return r;
+}
+
+// Same split as the lazy version, so one pass compares like with like.
+std::uint64_t passes_eager(std::string_view text, int passes) {
+    std::vector<std::string_view> kept;
+    std::ranges::copy(pipeline::lazy_words(text) | std::views::filter(pipeline::keep), std::back_inserter(kept));
+    std::uint64_t r = 0;
+    for (int p = 0; p < passes; ++p) {
+        r += statistic(kept, p % 4);
+    }
+    return r;
+}
+
+template <std::uint64_t (*Passes)(std::string_view, int)>
+void bm_repeated_traversal(state& st) {
+    auto const passes = static_cast<int>(st.arg(0));
+    std::string_view const text = corpus();
+    if (passes_lazy(text, passes) != passes_eager(text, passes)) {
+        st.error("lazy and eager statistics differ");
+        return;
+    }
+    for (auto _ : st) {
+        do_not_optimize(Passes(text, passes));
+    }
+    st.set_bytes_processed(st.iterations() * text.size());
+}
+CPPLEARN_BENCHMARK_NAMED("repeated_traversal/lazy", bm_repeated_traversal<passes_lazy>)
+    ->args_product({{1, 2, 4, 8}})
+    ->arg_names({"passes"});
+CPPLEARN_BENCHMARK_NAMED("repeated_traversal/eager", bm_repeated_traversal<passes_eager>)
+    ->args_product({{1, 2, 4, 8}})
+    ->arg_names({"passes"});
+
+// --- begin() of a fresh view vs a kept one ---------------------------------
+
+constexpr int queries = 64;
+constexpr std::size_t rare_length = 30;  // the longest word length in the corpus
+
+bool is_rare(std::string_view w) {
+    return w.size() >= rare_length;
+}
+
+auto rare_words(std::vector<std::string_view> const& words) {
+    return words | std::views::filter(is_rare);
+}
+
+void bm_first_match_fresh_view(state& st) {
+    auto const& words = corpus_words();
+    std::size_t sum = 0;
+    for (auto _ : st) {
+        sum = 0;
+        for (int q = 0; q < queries; ++q) {
+            sum += rare_words(words).front().size();
+        }
+        do_not_optimize(sum);
+    }
+    if (sum != queries * rare_length) {
+        st.error("wrong first match");
+    }
+    st.set_items_processed(st.iterations() * queries);
+}
+CPPLEARN_BENCHMARK_NAMED("first_match/fresh_view", bm_first_match_fresh_view);
+
+void bm_first_match_kept_view(state& st) {
+    auto const& words = corpus_words();
+    std::size_t sum = 0;
+    for (auto _ : st) {
+        sum = 0;
+        auto rare = rare_words(words);
+        for (int q = 0; q < queries; ++q) {
+            sum += rare.front().size();
+        }
+        do_not_optimize(sum);
+    }
+    if (sum != queries * rare_length) {
+        st.error("wrong first match");
+    }
+    st.set_items_processed(st.iterations() * queries);
+    auto const first = std::ranges::find_if(words, is_rare) - words.begin();
+    st.set_counter("first_match_index", static_cast<double>(first));
+}
+CPPLEARN_BENCHMARK_NAMED("first_match/kept_view", bm_first_match_kept_view);
+
+// --- random access into a filtered sequence --------------------------------
+
+constexpr int lookups = 256;
+
+std::vector<std::size_t> ranks(std::size_t survivors) {
+    std::mt19937 rng{9};
+    std::vector<std::size_t> r(lookups);
+    for (auto& x : r) {
+        x = rng() % survivors;
+    }
+    return r;
+}
+
+std::size_t nth_lazy(std::vector<std::string_view> const& words, std::vector<std::size_t> const& rs) {
+    auto kept = words | std::views::filter(pipeline::keep);
+    std::size_t sum = 0;
+    for (std::size_t rank : rs) {
+        sum += std::ranges::next(kept.begin(), static_cast<std::ptrdiff_t>(rank))->size();
+    }
+    return sum;
+}
+
+std::size_t nth_eager(std::vector<std::string_view> const& words, std::vector<std::size_t> const& rs) {
+    std::vector<std::string_view> kept;
+    std::ranges::copy_if(words, std::back_inserter(kept), pipeline::keep);
+    std::size_t sum = 0;
+    for (std::size_t rank : rs) {
+        sum += kept[rank].size();
+    }
+    return sum;
+}
+
+template <std::size_t (*Nth)(std::vector<std::string_view> const&, std::vector<std::size_t> const&)>
+void bm_nth_match(state& st) {
+    auto const& words = corpus_words();
+    auto const survivors = static_cast<std::size_t>(std::ranges::count_if(words, pipeline::keep));
+    auto const rs = ranks(survivors);
+    if (nth_lazy(words, rs) != nth_eager(words, rs)) {
+        st.error("lazy and eager lookups differ");
+        return;
+    }
+    for (auto _ : st) {
+        do_not_optimize(Nth(words, rs));
+    }
+    st.set_items_processed(st.iterations() * lookups);
+}
+CPPLEARN_BENCHMARK_NAMED("nth_match/lazy", bm_nth_match<nth_lazy>);
+CPPLEARN_BENCHMARK_NAMED("nth_match/eager", bm_nth_match<nth_eager>);
+
+}  // namespace
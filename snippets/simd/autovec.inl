@@ -0,0 +1,56 @@
+// Straightforward loops left to the auto-vectorizer.  Included by
+// autovec_sse2.cpp and autovec_avx2.cpp, which are compiled with -O3,
+// reassociation enabled (otherwise float reductions cannot be vectorized) and,
+// for the AVX2 variant, -mavx2 -mfma.  GCC vectorizes sum and dot; the loop-
+// carried dependency of the prefix sum and the early exit of find_byte keep
+// those two scalar, which is what the hand-written versions are for.
+//
+// Expects AUTOVEC_NAME, AUTOVEC_ISA and AUTOVEC_ACCESSOR to be defined.
+
+#include "kernels.hpp"
+
+namespace simd {
+
+namespace {
+
+float sum(float const* data, std::size_t n) {
+    float acc = 0.0f;
+    for (std::size_t i = 0; i < n; ++i) {
+        acc += data[i];
+    }
+    return acc;
+}
+
+float dot(float const* a, float const* b, std::size_t n) {
+    float acc = 0.0f;
+    for (std::size_t i = 0; i < n; ++i) {
+        acc += a[i] * b[i];
+    }
+    return acc;
+}
+
+void prefix_sum(std::uint32_t const* in, std::uint32_t* out, std::size_t n) {
+    std::uint32_t acc = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        acc += in[i];
+        out[i] = acc;
+    }
+}
+
+std::size_t find_byte(std::uint8_t const* data, std::size_t n, std::uint8_t needle) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (data[i] == needle) {
+            return i;
+        }
+    }
+    return n;
+}
+
+}  // namespace
+
+kernel_set const& AUTOVEC_ACCESSOR() {
+    static constexpr kernel_set set{AUTOVEC_NAME, AUTOVEC_ISA, sum, dot, prefix_sum, find_byte};
+    return set;
+}
+
+}  // namespace simd
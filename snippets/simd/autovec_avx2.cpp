@@ -0,0 +1,4 @@
+#define AUTOVEC_NAME "autovec_avx2"
+#define AUTOVEC_ISA "avx2"
+#define AUTOVEC_ACCESSOR autovec_avx2_kernels
+#include "autovec.inl"
@@ -0,0 +1,4 @@
+#define AUTOVEC_NAME "autovec_sse2"
+#define AUTOVEC_ISA "baseline"
+#define AUTOVEC_ACCESSOR autovec_sse2_kernels
+#include "autovec.inl"
@@ -0,0 +1,35 @@
+// Runtime selection of the widest kernel set the CPU supports.
+
+#include "kernels.hpp"
+
+#include <cstring>
+#include <initializer_list>
+
+namespace simd {
+
+bool cpu_supports(char const* isa) {
+    if (std::strcmp(isa, "baseline") == 0) {
+        return true;
+    }
+    if (std::strcmp(isa, "sse4.2") == 0) {
+        return __builtin_cpu_supports("sse4.2");
+    }
+    if (std::strcmp(isa, "avx2") == 0) {
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    }
+    return false;
+}
+
+kernel_set const& best_kernels() {
+    static kernel_set const& best = []() -> kernel_set const& {
+        for (kernel_set const* candidate : {&avx2_kernels(), &sse_kernels()}) {
+            if (cpu_supports(candidate->isa)) {
+                return *candidate;
+            }
+        }
+        return autovec_sse2_kernels();
+    }();
+    return best;
+}
+
+}  // namespace simd
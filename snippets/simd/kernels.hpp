@@ -0,0 +1,43 @@
+// Four kernels, several implementations each.
+//
+// Every implementation fills in a kernel_set; the benchmarks compare them with
+// the scalar set for correctness and then time them.  Sets compiled for an
+// instruction set the CPU lacks are never called (see dispatch.cpp).
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace simd {
+
+struct kernel_set {
+    char const* name;
+    // Instruction set the code was compiled for: "baseline", "sse4.2" or "avx2".
+    char const* isa;
+    float (*sum)(float const* data, std::size_t n);
+    float (*dot)(float const* a, float const* b, std::size_t n);
+    // Inclusive prefix sum, wrapping on overflow.
+    void (*prefix_sum)(std::uint32_t const* in, std::uint32_t* out, std::size_t n);
+    // Index of the first `needle` in `data`, or n if absent.
+    std::size_t (*find_byte)(std::uint8_t const* data, std::size_t n, std::uint8_t needle);
+};
+
+// Plain loops compiled with -fno-tree-vectorize: the reference.
+kernel_set const& scalar_kernels();
+// The same plain loops compiled with -O3 and reassociation allowed, for the
+// baseline ISA and for AVX2.
+kernel_set const& autovec_sse2_kernels();
+kernel_set const& autovec_avx2_kernels();
+// Hand-written intrinsics.
+kernel_set const& sse_kernels();
+kernel_set const& avx2_kernels();
+// std::experimental::simd (Parallelism TS v2); null when the standard library
+// does not provide it.
+kernel_set const* stdx_sse2_kernels();
+kernel_set const* stdx_avx2_kernels();
+
+bool cpu_supports(char const* isa);
+// The fastest set this CPU can run, picked once at startup.
+kernel_set const& best_kernels();
+
+}  // namespace simd
@@ -0,0 +1,50 @@
+// Reference implementations.  Built with -fno-tree-vectorize so the numbers
+// show genuinely scalar code.
+
+#include "kernels.hpp"
+
+namespace simd {
+
+namespace {
+
+float sum(float const* data, std::size_t n) {
+    float acc = 0.0f;
+    for (std::size_t i = 0; i < n; ++i) {
+        acc += data[i];
+    }
+    return acc;
+}
+
+float dot(float const* a, float const* b, std::size_t n) {
+    float acc = 0.0f;
+    for (std::size_t i = 0; i < n; ++i) {
+        acc += a[i] * b[i];
+    }
+    return acc;
+}
+
+void prefix_sum(std::uint32_t const* in, std::uint32_t* out, std::size_t n) {
+    std::uint32_t acc = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        acc += in[i];
+        out[i] = acc;
+    }
+}
+
+std::size_t find_byte(std::uint8_t const* data, std::size_t n, std::uint8_t needle) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (data[i] == needle) {
+            return i;
+        }
+    }
+    return n;
+}
+
+}  // namespace
+
+kernel_set const& scalar_kernels() {
+    static constexpr kernel_set set{"scalar", "baseline", sum, dot, prefix_sum, find_byte};
+    return set;
+}
+
+}  // namespace simd
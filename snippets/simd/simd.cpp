@@ -0,0 +1,145 @@
+// Reductions, dot products, prefix sums and byte search: scalar vs
+// auto-vectorized vs intrinsics vs std::experimental::simd.
+//
+// Every variant is checked against the scalar kernel before it is timed.  The
+// inputs are multiples of 1/4 small enough that every float sum is exact, so
+// reassociated (vectorized) reductions must match bit for bit.  The `dispatch`
+// rows call whatever best_kernels() picked and name it in the label.
+
+#include "kernels.hpp"
+
+#include <cpplearn/bench.hpp>
+
+#include <initializer_list>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+using simd::kernel_set;
+
+enum class kernel { sum, dot, prefix_sum, find_byte };
+
+constexpr char const* kernel_name(kernel k) {
+    switch (k) {
+    case kernel::sum: return "sum";
+    case kernel::dot: return "dot";
+    case kernel::prefix_sum: return "prefix_sum";
+    case kernel::find_byte: return "find_byte";
+    }
+    return "?";
+}
+
+struct inputs {
+    explicit inputs(std::size_t n) : a(n), b(n), ints(n), scan(n), bytes(n) {
+        std::mt19937 rng{7};
+        for (std::size_t i = 0; i < n; ++i) {
+            a[i] = static_cast<float>(rng() % 5) * 0.25f;
+            b[i] = static_cast<float>(rng() % 5) * 0.25f;
+            ints[i] = static_cast<std::uint32_t>(rng());
+            bytes[i] = static_cast<std::uint8_t>(rng() % 255);
+        }
+        bytes[n - 1] = needle;  // worst case: the whole buffer is scanned
+    }
+
+    static constexpr std::uint8_t needle = 255;
+    std::vector<float> a, b;
+    std::vector<std::uint32_t> ints, scan;
+    std::vector<std::uint8_t> bytes;
+};
+
+// Runs kernel `k` of `set` once; returns false if it disagrees with scalar.
+bool matches_scalar(kernel k, kernel_set const& set, inputs& in) {
+    auto const& ref = simd::scalar_kernels();
+    std::size_t const n = in.a.size();
+    switch (k) {
+    case kernel::sum: return set.sum(in.a.data(), n) == ref.sum(in.a.data(), n);
+    case kernel::dot: return set.dot(in.a.data(), in.b.data(), n) == ref.dot(in.a.data(), in.b.data(), n);
+    case kernel::prefix_sum: {
+        std::vector<std::uint32_t> expected(n);
+        ref.prefix_sum(in.ints.data(), expected.data(), n);
+        set.prefix_sum(in.ints.data(), in.scan.data(), n);
+        return in.scan == expected;
+    }
+    case kernel::find_byte:
+        return set.find_byte(in.bytes.data(), n, inputs::needle) == ref.find_byte(in.bytes.data(), n, inputs::needle);
+    }
+    return false;
+}
+
+void bm_kernel(state& st, kernel k, kernel_set const* fixed_set) {
+    kernel_set const& set = fixed_set ? *fixed_set : simd::best_kernels();
+    if (!simd::cpu_supports(set.isa)) {
+        st.skip(std::string{"CPU lacks "} + set.isa);
+        return;
+    }
+    auto const n = static_cast<std::size_t>(st.arg(0));
+    inputs in{n};
+    if (!matches_scalar(k, set, in)) {
+        st.error(std::string{set.name} + " " + kernel_name(k) + " differs from scalar");
+        return;
+    }
+
+    std::size_t bytes_per_iteration = 0;
+    switch (k) {
+    case kernel::sum:
+        for (auto _ : st) {
+            do_not_optimize(set.sum(in.a.data(), n));
+        }
+        bytes_per_iteration = n * sizeof(float);
+        break;
+    case kernel::dot:
+        for (auto _ : st) {
+            do_not_optimize(set.dot(in.a.data(), in.b.data(), n));
+        }
+        bytes_per_iteration = 2 * n * sizeof(float);
+        break;
+    case kernel::prefix_sum:
+        for (auto _ : st) {
+            set.prefix_sum(in.ints.data(), in.scan.data(), n);
+            cpplearn::bench::clobber_memory();
+        }
+        bytes_per_iteration = 2 * n * sizeof(std::uint32_t);
+        break;
+    case kernel::find_byte:
+        for (auto _ : st) {
+            do_not_optimize(set.find_byte(in.bytes.data(), n, inputs::needle));
+        }
+        bytes_per_iteration = n;
+        break;
+    }
+    st.set_items_processed(st.iterations() * n);
+    st.set_bytes_processed(st.iterations() * bytes_per_iteration);
+    if (!fixed_set) {
+        st.set_label(set.name);
+    }
+}
+
+void register_kernel(kernel k, kernel_set const* set) {
+    std::string name = std::string{kernel_name(k)} + "/" + (set ? set->name : "dispatch");
+    cpplearn::bench::register_benchmark(std::move(name), [k, set](state& st) { bm_kernel(st, k, set); })
+        ->range(1 << 10, 1 << 20, 16);
+}
+
+[[maybe_unused]] bool const registered = [] {
+    std::vector<kernel_set const*> sets = {&simd::scalar_kernels(), &simd::autovec_sse2_kernels(),
+                                           &simd::autovec_avx2_kernels(), &simd::sse_kernels(),
+                                           &simd::avx2_kernels()};
+    for (auto* stdx_set : {simd::stdx_sse2_kernels(), simd::stdx_avx2_kernels()}) {
+        if (stdx_set) {
+            sets.push_back(stdx_set);
+        }
+    }
+    for (kernel k : {kernel::sum, kernel::dot, kernel::prefix_sum, kernel::find_byte}) {
+        for (auto const* set : sets) {
+            register_kernel(k, set);
+        }
+        register_kernel(k, nullptr);
+    }
+    return true;
+}();
+
+}  // namespace
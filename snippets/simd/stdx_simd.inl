@@ -0,0 +1,123 @@
+// std::experimental::simd versions.  The TS gives portable loads, arithmetic,
+// reductions and masks, but no lane shuffles, so the prefix sum builds its
+// shifted vectors with the generator constructor and relies on the compiler to
+// turn that back into shuffles.  Included by stdx_simd_sse2.cpp and
+// stdx_simd_avx2.cpp; native_simd picks the register width from the flags the
+// including file is compiled with.
+//
+// Expects STDX_NAME, STDX_ISA and STDX_ACCESSOR to be defined.
+
+#include "kernels.hpp"
+
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#endif
+
+namespace simd {
+
+#ifdef __cpp_lib_experimental_parallel_simd
+
+namespace {
+
+namespace stdx = std::experimental;
+
+float sum(float const* data, std::size_t n) {
+    using V = stdx::native_simd<float>;
+    V acc = 0.0f;
+    std::size_t i = 0;
+    for (; i + V::size() <= n; i += V::size()) {
+        acc += V{data + i, stdx::element_aligned};
+    }
+    float result = stdx::reduce(acc);
+    for (; i < n; ++i) {
+        result += data[i];
+    }
+    return result;
+}
+
+float dot(float const* a, float const* b, std::size_t n) {
+    using V = stdx::native_simd<float>;
+    V acc = 0.0f;
+    std::size_t i = 0;
+    for (; i + V::size() <= n; i += V::size()) {
+        acc += V{a + i, stdx::element_aligned} * V{b + i, stdx::element_aligned};
+    }
+    float result = stdx::reduce(acc);
+    for (; i < n; ++i) {
+        result += a[i] * b[i];
+    }
+    return result;
+}
+
+using uvec = stdx::native_simd<std::uint32_t>;
+
+// Lane j of the result is lane j - Shift of x, or 0.
+template <std::size_t Shift>
+uvec shift_up(uvec const& x) {
+    return uvec{[&](auto j) -> std::uint32_t {
+        constexpr std::size_t lane = decltype(j)::value;
+        if constexpr (lane >= Shift) {
+            return x[lane - Shift];
+        } else {
+            return 0u;
+        }
+    }};
+}
+
+template <std::size_t Shift = 1>
+uvec scan_lanes(uvec x) {
+    if constexpr (Shift < uvec::size()) {
+        return scan_lanes<Shift * 2>(x + shift_up<Shift>(x));
+    } else {
+        return x;
+    }
+}
+
+void prefix_sum(std::uint32_t const* in, std::uint32_t* out, std::size_t n) {
+    uvec carry = 0u;
+    std::size_t i = 0;
+    for (; i + uvec::size() <= n; i += uvec::size()) {
+        uvec const x = scan_lanes(uvec{in + i, stdx::element_aligned}) + carry;
+        x.copy_to(out + i, stdx::element_aligned);
+        carry = x[uvec::size() - 1];
+    }
+    std::uint32_t acc = carry[0];
+    for (; i < n; ++i) {
+        acc += in[i];
+        out[i] = acc;
+    }
+}
+
+std::size_t find_byte(std::uint8_t const* data, std::size_t n, std::uint8_t needle) {
+    using B = stdx::native_simd<std::uint8_t>;
+    std::size_t i = 0;
+    for (; i + B::size() <= n; i += B::size()) {
+        auto const hits = B{data + i, stdx::element_aligned} == needle;
+        if (stdx::any_of(hits)) {
+            return i + static_cast<std::size_t>(stdx::find_first_set(hits));
+        }
+    }
+    for (; i < n; ++i) {
+        if (data[i] == needle) {
+            return i;
+        }
+    }
+    return n;
+}
+
+}  // namespace
+
+kernel_set const* STDX_ACCESSOR() {
+    static constexpr kernel_set set{STDX_NAME, STDX_ISA, sum, dot, prefix_sum, find_byte};
+    return &set;
+}
+
+#else
+
+kernel_set const* STDX_ACCESSOR() {
+    return nullptr;
+}
+
+#endif
+
+}  // namespace simd
@@ -0,0 +1,4 @@
+#define STDX_NAME "stdx_simd_avx2"
+#define STDX_ISA "avx2"
+#define STDX_ACCESSOR stdx_avx2_kernels
+#include "stdx_simd.inl"
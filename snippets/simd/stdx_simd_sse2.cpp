@@ -0,0 +1,4 @@
+#define STDX_NAME "stdx_simd_sse2"
+#define STDX_ISA "baseline"
+#define STDX_ACCESSOR stdx_sse2_kernels
+#include "stdx_simd.inl"
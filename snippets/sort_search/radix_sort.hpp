@@ -0,0 +1,102 @@
+// LSD radix sort for integer and floating-point keys.
+//
+// One byte per pass, least significant first; each pass is a stable counting
+// sort, so after the last one the keys are in order.  A single read of the
+// input fills the histograms of every pass at once, and a pass is skipped
+// when all keys share its byte (the high bytes of small integers, say).  The
+// cost is O(n * sizeof(key)) with no comparisons and no data-dependent
+// branches, paid for with an n-element scratch buffer and scattered writes
+// into 256 output streams per pass.
+//
+// Keys are sorted by an unsigned image that orders like the key:
+// signed integers flip the sign bit, floats flip the sign bit of positives
+// and every bit of negatives.  The image is recomputed in each pass rather
+// than stored.  Floats order like operator< except that -0.0 precedes +0.0
+// and NaNs go to the ends (by sign); callers with NaNs should not expect the
+// result std::sort would give, which is unspecified for them anyway.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace sort_search {
+
+template <class T>
+struct radix_traits;
+
+template <class T>
+    requires std::is_unsigned_v<T>
+struct radix_traits<T> {
+    using bits = T;
+    static bits image(T x) noexcept { return x; }
+};
+
+template <class T>
+    requires(std::is_signed_v<T> && std::is_integral_v<T>)
+struct radix_traits<T> {
+    using bits = std::make_unsigned_t<T>;
+    static bits image(T x) noexcept {
+        return static_cast<bits>(x) ^ (bits{1} << (8 * sizeof(T) - 1));
+    }
+};
+
+template <class T>
+    requires std::is_floating_point_v<T>
+struct radix_traits<T> {
+    using bits = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    static bits image(T x) noexcept {
+        bits const b = std::bit_cast<bits>(x);
+        bits const sign = bits{1} << (8 * sizeof(T) - 1);
+        return b & sign ? ~b : b | sign;
+    }
+};
+
+// Sorts `keys` ascending; `scratch` must hold at least keys.size() elements.
+template <class T>
+void radix_sort(std::span<T> keys, std::span<T> scratch) {
+    using traits = radix_traits<T>;
+    using bits = typename traits::bits;
+    constexpr unsigned passes = sizeof(bits);
+    std::size_t const n = keys.size();
+    if (n < 2) {
+        return;
+    }
+
+    std::array<std::array<std::size_t, 256>, passes> counts{};
+    for (T const& x : keys) {
+        bits const b = traits::image(x);
+        for (unsigned p = 0; p < passes; ++p) {
+            ++counts[p][(b >> (8 * p)) & 0xff];
+        }
+    }
+
+    T* from = keys.data();
+    T* to = scratch.data();
+    for (unsigned p = 0; p < passes; ++p) {
+        auto& offsets = counts[p];
+        unsigned const shift = 8 * p;
+        if (offsets[(traits::image(from[0]) >> shift) & 0xff] == n) {
+            continue;
+        }
+        std::size_t sum = 0;
+        for (auto& c : offsets) {
+            sum += std::exchange(c, sum);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            T const x = from[i];
+            to[offsets[(traits::image(x) >> shift) & 0xff]++] = x;
+        }
+        std::swap(from, to);
+    }
+    if (from != keys.data()) {
+        std::copy(from, from + n, keys.data());
+    }
+}
+
+}  // namespace sort_search
@@ -0,0 +1,125 @@
+// Lower bound in a sorted array, three ways.
+//
+// std::lower_bound  halves the range with a branch on every comparison.  On
+//                   random queries that branch is a coin flip, so about half
+//                   the steps mispredict, and the CPU cannot start the next
+//                   load before the comparison resolves.
+// branchless        the same halving with the comparison turned into
+//                   arithmetic (GCC compiles the obvious `?:` back into a
+//                   branch): no mispredictions, and the loop runs
+//                   a fixed log2(n) steps.  Each load still depends on the
+//                   one before, but both possible next probes are known, so
+//                   the prefetching version requests both a step ahead.
+// eytzinger         the array rearranged in breadth-first order of the
+//                   implicit search tree: the root at 1, the children of k
+//                   at 2k and 2k+1.  The first levels of the tree share a
+//                   few cache lines that stay hot, and the 16 descendants
+//                   four levels below k are adjacent (for 4-byte keys), so
+//                   one prefetch of a 64-byte line covers every path the
+//                   search can take four steps ahead.
+//
+// All three return the first position whose element is not less than the
+// key; eytzinger returns it in its own layout (0 for "past the end").
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+
+namespace sort_search {
+
+inline constexpr std::size_t cache_line = 64;
+
+template <class T>
+std::size_t branchless_lower_bound(std::span<T const> a, T key) noexcept {
+    if (a.empty()) {
+        return 0;
+    }
+    T const* base = a.data();
+    std::size_t n = a.size();
+    while (n > 1) {
+        std::size_t const half = n / 2;
+        base += (base[half - 1] < key) * half;
+        n -= half;
+    }
+    return static_cast<std::size_t>(base - a.data()) + (*base < key);
+}
+
+template <class T>
+std::size_t branchless_lower_bound_prefetch(std::span<T const> a, T key) noexcept {
+    if (a.empty()) {
+        return 0;
+    }
+    T const* base = a.data();
+    std::size_t n = a.size();
+    while (n > 1) {
+        std::size_t const half = n / 2;
+        // The next probe is base[half / 2 - 1] or base[half + half / 2 - 1]
+        // depending on this comparison; ask for both.
+        __builtin_prefetch(base + half / 2);
+        __builtin_prefetch(base + half + half / 2);
+        base += (base[half - 1] < key) * half;
+        n -= half;
+    }
+    return static_cast<std::size_t>(base - a.data()) + (*base < key);
+}
+
+// The sorted values in Eytzinger order, in a cache-line-aligned block whose
+// element 0 is unused, so that the children of k start a line-aligned group
+// whenever k is a multiple of the keys per line.
+template <class T>
+class eytzinger {
+public:
+    static constexpr std::size_t keys_per_line = cache_line / sizeof(T);
+
+    explicit eytzinger(std::span<T const> sorted)
+        : n_{sorted.size()},
+          data_{static_cast<T*>(::operator new[]((n_ + 1) * sizeof(T), std::align_val_t{cache_line}))} {
+        std::size_t i = 0;
+        fill(sorted, i, 1);
+    }
+
+    std::size_t size() const noexcept { return n_; }
+
+    // Index of the lower bound in this layout, 0 if every element is less.
+    template <bool Prefetch>
+    std::size_t lower_bound(T key) const noexcept {
+        T const* const b = data_.get();
+        std::size_t k = 1;
+        while (k <= n_) {
+            if constexpr (Prefetch) {
+                __builtin_prefetch(b + k * keys_per_line);
+            }
+            k = 2 * k + (b[k] < key);
+        }
+        // The path went right (1 bits) past every smaller element; undo those
+        // steps and the last left turn to land on the answer.
+        return k >> (std::countr_one(k) + 1);
+    }
+
+    T const& operator[](std::size_t k) const noexcept { return data_[k]; }
+
+    std::size_t bytes() const noexcept { return (n_ + 1) * sizeof(T); }
+
+private:
+    struct aligned_delete {
+        void operator()(T* p) const noexcept { ::operator delete[](p, std::align_val_t{cache_line}); }
+    };
+
+    // In-order walk of the implicit tree, handing out sorted values in turn.
+    void fill(std::span<T const> sorted, std::size_t& i, std::size_t k) {
+        if (k <= n_) {
+            fill(sorted, i, 2 * k);
+            data_[k] = sorted[i++];
+            fill(sorted, i, 2 * k + 1);
+        }
+    }
+
+    std::size_t n_;
+    std::unique_ptr<T[], aligned_delete> data_;
+};
+
+}  // namespace sort_search
@@ -0,0 +1,120 @@
+// std::lower_bound vs branchless vs Eytzinger-layout searches (search.hpp)
+// over sorted 32-bit keys, 1K (L1) to 16M (64 MiB, DRAM).
+//
+// One iteration answers a batch of 4096 random queries, fixed per size;
+// items/s counts queries.  The queries are independent, so out-of-order
+// execution may overlap several searches: the comparison is throughput, which
+// is what a batch lookup sees.  In cache, the branchless loop wins by not
+// mispredicting; once the array spills, every search is a chain of dependent
+// cache misses and prefetching decides the race.  Eytzinger pays for its
+// speed with a separate layout: the answer is a position in that layout, not
+// in the sorted array.
+
+#include "search.hpp"
+
+#include <cpplearn/bench.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+using key = std::uint32_t;
+
+constexpr std::int64_t min_keys = 1 << 10;
+constexpr std::int64_t max_keys = 1 << 24;
+constexpr std::size_t batch = 4096;
+
+struct data_set {
+    std::vector<key> sorted;
+    std::vector<key> queries;
+};
+
+// Sorted random keys, and queries drawn from the same range so that a few
+// land past the last key.
+data_set make_data(std::size_t n) {
+    std::mt19937 rng{29};
+    data_set d;
+    d.sorted.resize(n);
+    std::generate(d.sorted.begin(), d.sorted.end(), rng);
+    std::sort(d.sorted.begin(), d.sorted.end());
+    d.queries.resize(batch);
+    std::generate(d.queries.begin(), d.queries.end(), rng);
+    return d;
+}
+
+// Every search reports the value it found (0 past the end), so all of them
+// can be checked against std::lower_bound with one checksum.
+struct std_lower_bound {
+    std::span<key const> a;
+    key find(key x) const noexcept {
+        auto const it = std::lower_bound(a.begin(), a.end(), x);
+        return it == a.end() ? 0 : *it;
+    }
+};
+
+template <bool Prefetch>
+struct branchless {
+    std::span<key const> a;
+    key find(key x) const noexcept {
+        std::size_t const i = Prefetch ? sort_search::branchless_lower_bound_prefetch(a, x)
+                                       : sort_search::branchless_lower_bound(a, x);
+        return i == a.size() ? 0 : a[i];
+    }
+};
+
+template <bool Prefetch>
+struct eytzinger {
+    sort_search::eytzinger<key> tree;
+    explicit eytzinger(std::span<key const> a) : tree{a} {}
+    key find(key x) const noexcept {
+        std::size_t const k = tree.template lower_bound<Prefetch>(x);
+        return k == 0 ? 0 : tree[k];
+    }
+};
+
+template <class Search>
+std::uint64_t run(Search const& s, std::span<key const> queries) {
+    std::uint64_t sum = 0;
+    for (key const q : queries) {
+        sum += s.find(q);
+    }
+    return sum;
+}
+
+template <class Search>
+void bm_search(state& st) {
+    auto const n = static_cast<std::size_t>(st.arg(0));
+    auto const d = make_data(n);
+    Search const s{std::span<key const>{d.sorted}};
+
+    if (run(s, d.queries) != run(std_lower_bound{d.sorted}, d.queries)) {
+        st.error("result differs from std::lower_bound");
+        return;
+    }
+
+    for (auto _ : st) {
+        do_not_optimize(run(s, d.queries));
+    }
+
+    st.set_label(cpplearn::bench::cache_fit(n * sizeof(key)));
+    st.set_items_processed(st.iterations() * batch);
+}
+
+[[maybe_unused]] bool const registered = [] {
+    using cpplearn::bench::register_benchmark;
+    auto add = [](char const* name, auto fn) { register_benchmark(name, fn)->range(min_keys, max_keys, 4); };
+    add("search/lower_bound", bm_search<std_lower_bound>);
+    add("search/branchless", bm_search<branchless<false>>);
+    add("search/branchless_prefetch", bm_search<branchless<true>>);
+    add("search/eytzinger", bm_search<eytzinger<false>>);
+    add("search/eytzinger_prefetch", bm_search<eytzinger<true>>);
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,120 @@
+// std::sort and std::stable_sort vs LSD radix sort (radix_sort.hpp) for
+// uniformly random 32-bit, 64-bit and float keys, 1K to 4M of them.
+//
+// Comparison sorts do n log n work, and std::sort's partitioning branches on
+// every comparison of random data.  Radix sort does a fixed number of linear
+// passes (4 for 32-bit keys, 8 for 64-bit) whatever n is, so its time per key
+// stays flat while the comparison sorts' grows with log n, until the array
+// and its scratch copy leave the cache and every pass streams from DRAM.
+// Each iteration sorts a fresh copy of an input, copied outside the timed
+// region.  The inputs rotate through a pool of at least 1M keys: sorting the
+// same small array over and over lets the branch predictor learn its
+// comparison outcomes, which made std::sort look four times faster on 1K
+// keys than on data it had not seen.  The label names the cache level that
+// holds the keys being sorted.
+
+#include "radix_sort.hpp"
+
+#include <cpplearn/bench.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+
+constexpr std::int64_t min_keys = 1 << 10;
+constexpr std::int64_t max_keys = 1 << 22;
+constexpr std::size_t pool_keys = 1 << 20;
+
+template <class T>
+std::vector<T> make_keys(std::size_t n, std::mt19937_64& rng) {
+    std::vector<T> keys(n);
+    if constexpr (std::is_floating_point_v<T>) {
+        // Both signs and a spread of exponents, so every byte of the image varies.
+        std::uniform_real_distribution<T> mantissa{-1, 1};
+        std::uniform_int_distribution<int> exponent{-20, 20};
+        for (auto& k : keys) {
+            k = std::ldexp(mantissa(rng), exponent(rng));
+        }
+    } else {
+        for (auto& k : keys) {
+            k = static_cast<T>(rng());
+        }
+    }
+    return keys;
+}
+
+struct std_sort {
+    template <class T>
+    static void sort(std::span<T> keys, std::span<T>) { std::sort(keys.begin(), keys.end()); }
+};
+
+struct std_stable_sort {
+    template <class T>
+    static void sort(std::span<T> keys, std::span<T>) { std::stable_sort(keys.begin(), keys.end()); }
+};
+
+struct radix {
+    template <class T>
+    static void sort(std::span<T> keys, std::span<T> scratch) { sort_search::radix_sort(keys, scratch); }
+};
+
+template <class Sort, class T>
+void bm_sort(state& st) {
+    auto const n = static_cast<std::size_t>(st.arg(0));
+    std::mt19937_64 rng{23};
+    std::vector<std::vector<T>> inputs((pool_keys + n - 1) / n);
+    for (auto& input : inputs) {
+        input = make_keys<T>(n, rng);
+    }
+    std::vector<T> keys(n);
+    std::vector<T> scratch(n);
+
+    auto expected = inputs[0];
+    std::sort(expected.begin(), expected.end());
+    keys = inputs[0];
+    Sort::sort(std::span{keys}, std::span{scratch});
+    if (keys != expected) {
+        st.error("result differs from std::sort");
+        return;
+    }
+
+    std::size_t next = 0;
+    for (auto _ : st) {
+        st.pause_timing();
+        std::copy(inputs[next].begin(), inputs[next].end(), keys.begin());
+        next = next + 1 == inputs.size() ? 0 : next + 1;
+        st.resume_timing();
+        Sort::sort(std::span{keys}, std::span{scratch});
+        do_not_optimize(keys.data());
+    }
+
+    st.set_label(cpplearn::bench::cache_fit(n * sizeof(T)));
+    st.set_items_processed(st.iterations() * n);
+    st.set_bytes_processed(st.iterations() * n * sizeof(T));
+}
+
+[[maybe_unused]] bool const registered = [] {
+    using cpplearn::bench::register_benchmark;
+    auto add = [](char const* name, auto fn) { register_benchmark(name, fn)->range(min_keys, max_keys, 4); };
+    add("sort/std_sort/u32", bm_sort<std_sort, std::uint32_t>);
+    add("sort/std_stable_sort/u32", bm_sort<std_stable_sort, std::uint32_t>);
+    add("sort/radix/u32", bm_sort<radix, std::uint32_t>);
+    add("sort/std_sort/u64", bm_sort<std_sort, std::uint64_t>);
+    add("sort/std_stable_sort/u64", bm_sort<std_stable_sort, std::uint64_t>);
+    add("sort/radix/u64", bm_sort<radix, std::uint64_t>);
+    add("sort/std_sort/float", bm_sort<std_sort, float>);
+    add("sort/std_stable_sort/float", bm_sort<std_stable_sort, float>);
+    add("sort/radix/float", bm_sort<radix, float>);
+    return true;
+}();
+
+}  // namespace
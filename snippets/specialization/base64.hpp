@@ -0,0 +1,60 @@
+// The base64 alphabet, its inverse derived at compile time, and the decode loop
+// shared by the decode variants (which differ only in how they map a
+// character back to its 6-bit value).
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace specialization {
+
+inline constexpr std::string_view base64_alphabet =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// 0xff marks bytes outside the alphabet.
+inline constexpr std::uint8_t base64_invalid = 0xff;
+
+constexpr std::array<std::uint8_t, 256> make_base64_decode_table() {
+    std::array<std::uint8_t, 256> t{};
+    t.fill(base64_invalid);
+    for (std::size_t i = 0; i < base64_alphabet.size(); ++i) {
+        t[static_cast<unsigned char>(base64_alphabet[i])] = static_cast<std::uint8_t>(i);
+    }
+    return t;
+}
+
+// Four characters to three bytes; padding only in the last group.
+// `decode_char(char) -> std::uint8_t` returns base64_invalid for bad input.
+template <class DecodeChar>
+std::ptrdiff_t decode_base64(std::string_view in, std::uint8_t* out, DecodeChar decode_char) {
+    if (in.size() % 4 != 0) {
+        return -1;
+    }
+    std::uint8_t* const start = out;
+    for (std::size_t i = 0; i < in.size(); i += 4) {
+        bool const last = i + 4 == in.size();
+        std::size_t const pad = last ? (in[i + 3] == '=') + (in[i + 2] == '=') : 0;
+        std::uint32_t group = 0;
+        std::uint8_t bad = 0;
+        for (std::size_t k = 0; k < 4 - pad; ++k) {
+            std::uint8_t const v = decode_char(in[i + k]);
+            bad |= v == base64_invalid;
+            group |= std::uint32_t{v} << (18 - 6 * k);
+        }
+        if (bad) {
+            return -1;
+        }
+        *out++ = static_cast<std::uint8_t>(group >> 16);
+        if (pad < 2) {
+            *out++ = static_cast<std::uint8_t>(group >> 8);
+        }
+        if (pad < 1) {
+            *out++ = static_cast<std::uint8_t>(group);
+        }
+    }
+    return out - start;
+}
+
+}  // namespace specialization
@@ -0,0 +1,29 @@
+#include "base64.hpp"
+#include "variants.hpp"
+
+namespace specialization {
+
+// The character classes tested one after another, as written by hand when no
+// table is at hand.  On random base64 text the branches are unpredictable.
+std::ptrdiff_t base64_decode_branchy(std::string_view in, std::uint8_t* out) {
+    return decode_base64(in, out, [](char c) -> std::uint8_t {
+        if (c >= 'A' && c <= 'Z') {
+            return static_cast<std::uint8_t>(c - 'A');
+        }
+        if (c >= 'a' && c <= 'z') {
+            return static_cast<std::uint8_t>(c - 'a' + 26);
+        }
+        if (c >= '0' && c <= '9') {
+            return static_cast<std::uint8_t>(c - '0' + 52);
+        }
+        if (c == '+') {
+            return 62;
+        }
+        if (c == '/') {
+            return 63;
+        }
+        return base64_invalid;
+    });
+}
+
+}  // namespace specialization
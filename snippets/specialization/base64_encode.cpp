@@ -0,0 +1,29 @@
+#include "base64.hpp"
+#include "variants.hpp"
+
+namespace specialization {
+
+std::size_t base64_encode(bytes in, char* out) {
+    char* const start = out;
+    std::size_t i = 0;
+    for (; i + 3 <= in.size(); i += 3) {
+        std::uint32_t const group = std::uint32_t{in[i]} << 16 | std::uint32_t{in[i + 1]} << 8 | in[i + 2];
+        *out++ = base64_alphabet[group >> 18];
+        *out++ = base64_alphabet[(group >> 12) & 63];
+        *out++ = base64_alphabet[(group >> 6) & 63];
+        *out++ = base64_alphabet[group & 63];
+    }
+    if (std::size_t const rest = in.size() - i; rest != 0) {
+        std::uint32_t group = std::uint32_t{in[i]} << 16;
+        if (rest == 2) {
+            group |= std::uint32_t{in[i + 1]} << 8;
+        }
+        *out++ = base64_alphabet[group >> 18];
+        *out++ = base64_alphabet[(group >> 12) & 63];
+        *out++ = rest == 2 ? base64_alphabet[(group >> 6) & 63] : '=';
+        *out++ = '=';
+    }
+    return static_cast<std::size_t>(out - start);
+}
+
+}  // namespace specialization
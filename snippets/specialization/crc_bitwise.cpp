@@ -0,0 +1,16 @@
+#include "variants.hpp"
+
+namespace specialization {
+
+std::uint32_t crc32_bitwise(bytes data) {
+    std::uint32_t crc = ~0u;
+    for (std::uint8_t b : data) {
+        crc ^= b;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+}  // namespace specialization
@@ -0,0 +1,38 @@
+#include "crc_table.hpp"
+#include "variants.hpp"
+
+#include <bit>
+#include <cstring>
+
+namespace specialization {
+
+namespace {
+
+// 8 KiB of .rodata: eight table lookups per 8 input bytes, independent of
+// each other, instead of a chain of eight dependent ones.
+constexpr auto tables = make_crc32_tables<8>();
+
+static_assert(std::endian::native == std::endian::little, "slicing-by-8 below assumes little-endian loads");
+
+}  // namespace
+
+std::uint32_t crc32_constexpr_slice8(bytes data) {
+    std::uint32_t crc = ~0u;
+    std::size_t i = 0;
+    for (; i + 8 <= data.size(); i += 8) {
+        std::uint32_t lo;
+        std::uint32_t hi;
+        std::memcpy(&lo, data.data() + i, 4);
+        std::memcpy(&hi, data.data() + i + 4, 4);
+        lo ^= crc;
+        crc = tables[7][lo & 0xff] ^ tables[6][(lo >> 8) & 0xff] ^ tables[5][(lo >> 16) & 0xff] ^
+              tables[4][lo >> 24] ^ tables[3][hi & 0xff] ^ tables[2][(hi >> 8) & 0xff] ^
+              tables[1][(hi >> 16) & 0xff] ^ tables[0][hi >> 24];
+    }
+    for (; i < data.size(); ++i) {
+        crc = (crc >> 8) ^ tables[0][(crc ^ data[i]) & 0xff];
+    }
+    return ~crc;
+}
+
+}  // namespace specialization
@@ -0,0 +1,22 @@
+#include "crc_table.hpp"
+#include "variants.hpp"
+
+namespace specialization {
+
+namespace {
+
+// 1 KiB of .rodata, no initialization at run time.
+constexpr auto tables = make_crc32_tables<1>();
+
+}  // namespace
+
+std::uint32_t crc32_constexpr_table(bytes data) {
+    auto const& t = tables[0];
+    std::uint32_t crc = ~0u;
+    for (std::uint8_t b : data) {
+        crc = (crc >> 8) ^ t[(crc ^ b) & 0xff];
+    }
+    return ~crc;
+}
+
+}  // namespace specialization
@@ -0,0 +1,36 @@
+#include "variants.hpp"
+
+#include <array>
+
+namespace specialization {
+
+namespace {
+
+// The same table as make_crc32_tables<1>(), built by an ordinary function so
+// that the compiler cannot fold it into .rodata: it lives in .bss and is
+// filled on the first call.
+std::array<std::uint32_t, 256> build_table() {
+    std::array<std::uint32_t, 256> t;
+    for (std::uint32_t b = 0; b < 256; ++b) {
+        std::uint32_t crc = b;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+        t[b] = crc;
+    }
+    return t;
+}
+
+}  // namespace
+
+// Every call goes through the initialization guard of the static.
+std::uint32_t crc32_runtime_table(bytes data) {
+    static auto const t = build_table();
+    std::uint32_t crc = ~0u;
+    for (std::uint8_t b : data) {
+        crc = (crc >> 8) ^ t[(crc ^ b) & 0xff];
+    }
+    return ~crc;
+}
+
+}  // namespace specialization
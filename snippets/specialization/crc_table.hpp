@@ -0,0 +1,29 @@
+// The CRC-32 lookup tables, computable both at run time and at compile time.
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace specialization {
+
+// table[k][b]: CRC of byte b followed by k zero bytes.  Slice k = 0 is the
+// classic 256-entry table.
+template <std::size_t Slices>
+constexpr std::array<std::array<std::uint32_t, 256>, Slices> make_crc32_tables() {
+    std::array<std::array<std::uint32_t, 256>, Slices> t{};
+    for (std::uint32_t b = 0; b < 256; ++b) {
+        std::uint32_t crc = b;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+        t[0][b] = crc;
+    }
+    for (std::size_t k = 1; k < Slices; ++k) {
+        for (std::uint32_t b = 0; b < 256; ++b) {
+            t[k][b] = (t[k - 1][b] >> 8) ^ t[0][t[k - 1][b] & 0xff];
+        }
+    }
+    return t;
+}
+
+}  // namespace specialization
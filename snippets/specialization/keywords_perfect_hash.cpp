@@ -0,0 +1,55 @@
+#include "keywords.hpp"
+#include "variants.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace specialization {
+
+namespace {
+
+constexpr unsigned table_bits = 10;
+
+constexpr std::uint32_t hash(std::string_view s, std::uint32_t seed) {
+    std::uint32_t h = 2166136261u ^ seed;
+    for (char c : s) {
+        h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+    return h >> (32 - table_bits);
+}
+
+struct perfect_hash {
+    std::uint32_t seed = 0;
+    // slot -> 1 + keyword index, 0 for empty.
+    std::array<std::uint8_t, 1u << table_bits> slots{};
+};
+
+// Tries seeds until the keywords land in distinct slots.  With 92 keys in
+// 1024 slots about one seed in fifty works, so the search is short; it runs
+// entirely inside the compiler.
+constexpr perfect_hash find_perfect_hash() {
+    for (std::uint32_t seed = 0;; ++seed) {
+        perfect_hash ph{seed, {}};
+        bool collision = false;
+        for (std::size_t i = 0; i < cpp_keywords.size() && !collision; ++i) {
+            auto& slot = ph.slots[hash(cpp_keywords[i], seed)];
+            collision = slot != 0;
+            slot = static_cast<std::uint8_t>(i + 1);
+        }
+        if (!collision) {
+            return ph;
+        }
+    }
+}
+
+// 1 KiB of .rodata.  Lookup: one hash, one load, one string comparison.
+constexpr perfect_hash table = find_perfect_hash();
+
+}  // namespace
+
+bool is_keyword_perfect_hash(std::string_view word) {
+    std::uint8_t const entry = table.slots[hash(word, table.seed)];
+    return entry != 0 && cpp_keywords[entry - 1u] == word;
+}
+
+}  // namespace specialization
@@ -0,0 +1,24 @@
+#include "keywords.hpp"
+#include "variants.hpp"
+
+#include <algorithm>
+
+namespace specialization {
+
+namespace {
+
+// std::sort is constexpr since C++20, so the sorted copy costs nothing at run
+// time.  Lookup is a binary search: about seven string comparisons.
+constexpr auto sorted_keywords = [] {
+    auto k = cpp_keywords;
+    std::sort(k.begin(), k.end());
+    return k;
+}();
+
+}  // namespace
+
+bool is_keyword_sorted(std::string_view word) {
+    return std::binary_search(sorted_keywords.begin(), sorted_keywords.end(), word);
+}
+
+}  // namespace specialization
@@ -0,0 +1,15 @@
+#include "keywords.hpp"
+#include "variants.hpp"
+
+#include <unordered_set>
+
+namespace specialization {
+
+// Built on first call: one heap node per keyword plus the bucket array, and a
+// full std::hash of the word on every lookup.
+bool is_keyword_unordered_set(std::string_view word) {
+    static std::unordered_set<std::string_view> const set(cpp_keywords.begin(), cpp_keywords.end());
+    return set.contains(word);
+}
+
+}  // namespace specialization
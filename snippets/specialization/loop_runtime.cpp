@@ -0,0 +1,3 @@
+#define LOOP_RUNTIME_NAME transform_runtime
+#define LOOP_RUNTIME_ATTRIBUTES
+#include "loop_runtime.inl"
@@ -0,0 +1,37 @@
+// The per-element loop with the options tested inside it.  Included by
+// loop_runtime.cpp as is, and by loop_runtime_no_unswitch.cpp with loop
+// unswitching turned off.  At -O3 GCC unswitches the loop on its own: it hoists
+// the invariant `opt` tests out and emits one specialized copy of the loop per
+// combination, i.e. what loop_template.cpp spells out by hand, and the object
+// grows to match.  Without unswitching each test stays in the loop and blocks
+// vectorization.
+//
+// Expects LOOP_RUNTIME_NAME and LOOP_RUNTIME_ATTRIBUTES to be defined.
+
+#include "variants.hpp"
+
+#include <algorithm>
+
+namespace specialization {
+
+LOOP_RUNTIME_ATTRIBUTES void LOOP_RUNTIME_NAME(std::span<float> data, transform_options const& opt) {
+    float const scale = opt.scale;
+    bool const square = opt.square;
+    bool const negate = opt.negate;
+    bool const clamp = opt.clamp;
+    for (float& x : data) {
+        float v = x * scale + 1.0f;
+        if (square) {
+            v = v * v;
+        }
+        if (negate) {
+            v = -v;
+        }
+        if (clamp) {
+            v = std::clamp(v, -1000.0f, 1000.0f);
+        }
+        x = v;
+    }
+}
+
+}  // namespace specialization
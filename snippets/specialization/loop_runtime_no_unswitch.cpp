@@ -0,0 +1,5 @@
+// The attribute rather than a per-file compile option, so that the standalone
+// compile behind compile_stats.inc sees it too.
+#define LOOP_RUNTIME_NAME transform_runtime_no_unswitch
+#define LOOP_RUNTIME_ATTRIBUTES [[gnu::optimize("no-unswitch-loops")]]
+#include "loop_runtime.inl"
@@ -0,0 +1,48 @@
+#include "variants.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace specialization {
+
+namespace {
+
+// One instantiation per combination of options; `if constexpr` drops the
+// disabled steps entirely, so each loop body is straight-line and vectorizes.
+template <bool Square, bool Negate, bool Clamp>
+void transform_fixed(std::span<float> data, float scale) {
+    for (float& x : data) {
+        float v = x * scale + 1.0f;
+        if constexpr (Square) {
+            v = v * v;
+        }
+        if constexpr (Negate) {
+            v = -v;
+        }
+        if constexpr (Clamp) {
+            v = std::clamp(v, -1000.0f, 1000.0f);
+        }
+        x = v;
+    }
+}
+
+using transform_fn = void (*)(std::span<float>, float);
+
+// All 2^3 instantiations, indexed by square | negate << 1 | clamp << 2.
+template <std::size_t... I>
+constexpr std::array<transform_fn, sizeof...(I)> make_dispatch_table(std::index_sequence<I...>) {
+    return {&transform_fixed<(I & 1) != 0, (I & 2) != 0, (I & 4) != 0>...};
+}
+
+constexpr auto dispatch_table = make_dispatch_table(std::make_index_sequence<8>{});
+
+}  // namespace
+
+// The runtime decision is made once per call, not once per element.
+void transform_template(std::span<float> data, transform_options const& opt) {
+    std::size_t const index = std::size_t{opt.square} | std::size_t{opt.negate} << 1 | std::size_t{opt.clamp} << 2;
+    dispatch_table[index](data, opt.scale);
+}
+
+}  // namespace specialization
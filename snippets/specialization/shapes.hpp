@@ -0,0 +1,72 @@
+// The same two shapes as a virtual hierarchy and as a CRTP hierarchy.
+//
+// Virtual: a loop over `shape const*` calls area() through the vtable; the
+// call cannot be inlined, so the loop cannot be vectorized, and with mixed
+// types the indirect branch is only as predictable as the order of the types.
+// CRTP: the derived type is a template argument, so area() is resolved and
+// inlined at compile time, but a container then holds one type only: mixing
+// types needs a std::variant or a virtual interface again.
+#pragma once
+
+#include <span>
+
+namespace specialization {
+
+namespace virtual_shapes {
+
+struct shape {
+    virtual ~shape() = default;
+    virtual double area() const = 0;
+};
+
+struct circle final : shape {
+    explicit circle(double r) : radius{r} {}
+    double area() const override;
+    double radius;
+};
+
+struct square final : shape {
+    explicit square(double s) : side{s} {}
+    double area() const override;
+    double side;
+};
+
+// shapes_virtual.cpp
+double total_area(std::span<shape const* const> shapes);
+
+}  // namespace virtual_shapes
+
+namespace crtp_shapes {
+
+template <class Derived>
+struct shape {
+    double area() const { return static_cast<Derived const&>(*this).area_impl(); }
+};
+
+struct circle : shape<circle> {
+    explicit circle(double r) : radius{r} {}
+    double area_impl() const { return 3.14159265358979323846 * radius * radius; }
+    double radius;
+};
+
+struct square : shape<square> {
+    explicit square(double s) : side{s} {}
+    double area_impl() const { return side * side; }
+    double side;
+};
+
+template <class Derived>
+double total_area(std::span<Derived const> shapes) {
+    double sum = 0.0;
+    for (auto const& s : shapes) {
+        sum += s.area();
+    }
+    return sum;
+}
+
+// shapes_crtp.cpp: the instantiation the benchmark calls.
+double total_circle_area(std::span<circle const> circles);
+
+}  // namespace crtp_shapes
+
+}  // namespace specialization
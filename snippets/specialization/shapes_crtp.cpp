@@ -0,0 +1,9 @@
+#include "shapes.hpp"
+
+namespace specialization::crtp_shapes {
+
+double total_circle_area(std::span<circle const> circles) {
+    return total_area(circles);
+}
+
+}  // namespace specialization::crtp_shapes
@@ -0,0 +1,21 @@
+#include "shapes.hpp"
+
+namespace specialization::virtual_shapes {
+
+double circle::area() const {
+    return 3.14159265358979323846 * radius * radius;
+}
+
+double square::area() const {
+    return side * side;
+}
+
+double total_area(std::span<shape const* const> shapes) {
+    double sum = 0.0;
+    for (shape const* s : shapes) {
+        sum += s->area();
+    }
+    return sum;
+}
+
+}  // namespace specialization::virtual_shapes
@@ -0,0 +1,269 @@
+// Compile-time specialization vs its run-time equivalent, with the cost.
+//
+// Next to the run-time numbers every benchmark reports, for the translation
+// unit holding the variant it times:
+//   compile_ms  compiler user CPU time for that file alone (best of three),
+//   code_bytes  its .text + .rodata + .data bytes, tables included,
+//   unwind_bytes  its .eh_frame + .gcc_except_table bytes.
+// Both are measured at build time by cpplearn_compile_stats() and are absent
+// when the build could not measure them.
+//
+// crc32/*         bitwise, a table built on first call, a constexpr table, and
+//                 constexpr slicing-by-8 tables, over `bytes` of input.
+// base64/*        decode with chained range checks vs a constexpr inverse table.
+// keywords/*      unordered_set vs binary search in a constexpr-sorted array vs
+//                 a perfect hash found at compile time, on a token stream with
+//                 about one keyword in three.
+// transform/*     a hot loop with options tested per element (with and without
+//                 the compiler's loop unswitching) vs one template instance per
+//                 combination of options; `flags` is the combination
+//                 (square | negate << 1 | clamp << 2).
+// shapes/*        summing areas through virtual calls (one type or two types
+//                 in random order) vs CRTP.
+
+#include "shapes.hpp"
+#include "variants.hpp"
+
+#include <cpplearn/bench.hpp>
+#include <cpplearn/compile_stats.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+namespace sp = specialization;
+
+constexpr cpplearn::bench::compile_stat compile_stats[] = {
+#include "compile_stats.inc"
+    {},
+};
+
+void report_compile_stats(state& st, std::string_view source) {
+    cpplearn::bench::report_compile_stats(st, compile_stats, source);
+}
+
+std::vector<std::uint8_t> random_bytes(std::size_t n) {
+    std::mt19937 rng{7};
+    std::vector<std::uint8_t> v(n);
+    for (auto& b : v) {
+        b = static_cast<std::uint8_t>(rng());
+    }
+    return v;
+}
+
+// --- CRC-32 ---------------------------------------------------------------
+
+void bm_crc32(state& st, std::uint32_t (*crc)(sp::bytes), std::string_view source) {
+    auto const data = random_bytes(static_cast<std::size_t>(st.arg(0)));
+    std::string_view const check = "123456789";
+    auto const* check_bytes = reinterpret_cast<std::uint8_t const*>(check.data());
+    if (crc({check_bytes, check.size()}) != 0xCBF43926u || crc(data) != sp::crc32_bitwise(data)) {
+        st.error("CRC differs from the reference");
+        return;
+    }
+    for (auto _ : st) {
+        do_not_optimize(crc(data));
+    }
+    st.set_bytes_processed(st.iterations() * data.size());
+    report_compile_stats(st, source);
+}
+
+// --- base64 ---------------------------------------------------------------
+
+void bm_base64_decode(state& st, std::ptrdiff_t (*decode)(std::string_view, std::uint8_t*),
+                      std::string_view source) {
+    auto const raw = random_bytes(48 << 10);
+    std::string encoded((raw.size() + 2) / 3 * 4, '\0');
+    encoded.resize(sp::base64_encode(raw, encoded.data()));
+    std::vector<std::uint8_t> decoded(raw.size());
+    if (decode(encoded, decoded.data()) != static_cast<std::ptrdiff_t>(raw.size()) || decoded != raw ||
+        decode("Zm9v!mFy", decoded.data()) != -1) {
+        st.error("decode does not round-trip");
+        return;
+    }
+    for (auto _ : st) {
+        do_not_optimize(decode(encoded, decoded.data()));
+    }
+    st.set_bytes_processed(st.iterations() * encoded.size());
+    report_compile_stats(st, source);
+}
+
+// --- keyword lookup -------------------------------------------------------
+
+std::vector<std::string> token_stream() {
+    static constexpr std::string_view identifiers[] = {
+        "value", "count", "index", "buffer", "result", "size", "data", "first", "last", "it",
+        "node", "parent", "left", "right", "key", "hash", "length", "offset", "begin", "end",
+        "const_ref", "returns", "classify", "intern", "format", "tmp", "x", "y", "lhs", "rhs"};
+    static constexpr std::string_view keywords[] = {
+        "const", "auto", "return", "if", "for", "int", "static_cast", "template", "typename",
+        "void", "noexcept", "constexpr", "while", "struct", "using", "namespace"};
+    std::mt19937 rng{11};
+    std::vector<std::string> tokens(4096);
+    for (auto& t : tokens) {
+        t = rng() % 3 == 0 ? keywords[rng() % std::size(keywords)] : identifiers[rng() % std::size(identifiers)];
+    }
+    return tokens;
+}
+
+void bm_keywords(state& st, bool (*is_keyword)(std::string_view), std::string_view source) {
+    auto const tokens = token_stream();
+    auto count = [&] {
+        std::size_t n = 0;
+        for (auto const& t : tokens) {
+            n += is_keyword(t);
+        }
+        return n;
+    };
+    std::size_t expected = 0;
+    for (auto const& t : tokens) {
+        expected += sp::is_keyword_sorted(t);
+    }
+    if (count() != expected || is_keyword("") || !is_keyword("co_yield") || is_keyword("co_yieldx")) {
+        st.error("keyword classification differs");
+        return;
+    }
+    for (auto _ : st) {
+        do_not_optimize(count());
+    }
+    st.set_items_processed(st.iterations() * tokens.size());
+    report_compile_stats(st, source);
+}
+
+// --- hot loop with options ------------------------------------------------
+
+sp::transform_options options_from(std::int64_t flags) {
+    return {0.5f, (flags & 1) != 0, (flags & 2) != 0, (flags & 4) != 0};
+}
+
+void bm_transform(state& st, void (*transform)(std::span<float>, sp::transform_options const&),
+                  std::string_view source) {
+    auto const opt = options_from(st.arg(0));
+    std::vector<float> data(4096);
+    std::iota(data.begin(), data.end(), -2048.0f);
+    auto expected = data;
+    sp::transform_runtime_no_unswitch(expected, opt);
+    auto check = data;
+    transform(check, opt);
+    if (check != expected) {
+        st.error("result differs from the reference loop");
+        return;
+    }
+    for (auto _ : st) {
+        transform(data, opt);
+        do_not_optimize(data.data());
+    }
+    st.set_items_processed(st.iterations() * data.size());
+    report_compile_stats(st, source);
+}
+
+// --- virtual vs CRTP --------------------------------------------------------
+
+constexpr std::size_t shape_count = 4096;
+
+void bm_shapes_virtual(state& st, bool mixed) {
+    std::mt19937 rng{3};
+    std::vector<sp::virtual_shapes::circle> circles;
+    std::vector<sp::virtual_shapes::square> squares;
+    circles.reserve(shape_count);
+    squares.reserve(shape_count);
+    std::vector<sp::virtual_shapes::shape const*> shapes;
+    for (std::size_t i = 0; i < shape_count; ++i) {
+        double const size = 1.0 + static_cast<double>(i % 7);
+        if (mixed && rng() % 2 == 0) {
+            shapes.push_back(&squares.emplace_back(size));
+        } else {
+            shapes.push_back(&circles.emplace_back(size));
+        }
+    }
+    for (auto _ : st) {
+        do_not_optimize(sp::virtual_shapes::total_area(shapes));
+    }
+    st.set_items_processed(st.iterations() * shape_count);
+    report_compile_stats(st, "shapes_virtual");
+}
+
+void bm_shapes_crtp(state& st) {
+    std::vector<sp::crtp_shapes::circle> circles;
+    std::vector<sp::virtual_shapes::circle> reference;
+    std::vector<sp::virtual_shapes::shape const*> reference_ptrs;
+    reference.reserve(shape_count);
+    for (std::size_t i = 0; i < shape_count; ++i) {
+        double const size = 1.0 + static_cast<double>(i % 7);
+        circles.emplace_back(size);
+        reference_ptrs.push_back(&reference.emplace_back(size));
+    }
+    if (sp::crtp_shapes::total_circle_area(circles) != sp::virtual_shapes::total_area(reference_ptrs)) {
+        st.error("CRTP and virtual sums differ");
+        return;
+    }
+    for (auto _ : st) {
+        do_not_optimize(sp::crtp_shapes::total_circle_area(circles));
+    }
+    st.set_items_processed(st.iterations() * shape_count);
+    report_compile_stats(st, "shapes_crtp");
+}
+
+[[maybe_unused]] bool const registered = [] {
+    using cpplearn::bench::register_benchmark;
+
+    struct crc_variant {
+        char const* name;
+        std::uint32_t (*fn)(sp::bytes);
+        char const* source;
+    };
+    for (auto const& v : {crc_variant{"bitwise", sp::crc32_bitwise, "crc_bitwise"},
+                          crc_variant{"runtime_table", sp::crc32_runtime_table, "crc_runtime_table"},
+                          crc_variant{"constexpr_table", sp::crc32_constexpr_table, "crc_constexpr_table"},
+                          crc_variant{"constexpr_slice8", sp::crc32_constexpr_slice8, "crc_constexpr_slice8"}}) {
+        register_benchmark(std::string{"crc32/"} + v.name, [v](state& st) { bm_crc32(st, v.fn, v.source); })
+            ->args_product({{64, 4096, 65536}})
+            ->arg_names({"bytes"});
+    }
+
+    register_benchmark("base64/branchy", [](state& st) {
+        bm_base64_decode(st, sp::base64_decode_branchy, "base64_branchy");
+    });
+    register_benchmark("base64/constexpr_table", [](state& st) {
+        bm_base64_decode(st, sp::base64_decode_constexpr, "base64_constexpr");
+    });
+
+    register_benchmark("keywords/unordered_set", [](state& st) {
+        bm_keywords(st, sp::is_keyword_unordered_set, "keywords_unordered_set");
+    });
+    register_benchmark("keywords/constexpr_sorted", [](state& st) {
+        bm_keywords(st, sp::is_keyword_sorted, "keywords_sorted");
+    });
+    register_benchmark("keywords/constexpr_perfect_hash", [](state& st) {
+        bm_keywords(st, sp::is_keyword_perfect_hash, "keywords_perfect_hash");
+    });
+
+    register_benchmark("transform/runtime_flags", [](state& st) {
+        bm_transform(st, sp::transform_runtime, "loop_runtime");
+    })->args_product({{0, 1, 7}})->arg_names({"flags"});
+    register_benchmark("transform/runtime_flags_no_unswitch", [](state& st) {
+        bm_transform(st, sp::transform_runtime_no_unswitch, "loop_runtime_no_unswitch");
+    })->args_product({{0, 1, 7}})->arg_names({"flags"});
+    register_benchmark("transform/template_flags", [](state& st) {
+        bm_transform(st, sp::transform_template, "loop_template");
+    })->args_product({{0, 1, 7}})->arg_names({"flags"});
+
+    register_benchmark("shapes/virtual_one_type", [](state& st) { bm_shapes_virtual(st, false); });
+    register_benchmark("shapes/virtual_two_types", [](state& st) { bm_shapes_virtual(st, true); });
+    register_benchmark("shapes/crtp", bm_shapes_crtp);
+    return true;
+}();
+
+}  // namespace
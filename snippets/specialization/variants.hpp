@@ -0,0 +1,47 @@
+// Entry points of the variant translation units.
+//
+// Every variant lives in its own .cpp so CMake can compile it alone and report
+// what it costs to build and how much code it adds (see compile_stats.inc,
+// keyed by file name).  The benchmarks call these through a plain function
+// call, so no variant is inlined into its caller.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace specialization {
+
+using bytes = std::span<std::uint8_t const>;
+
+// CRC-32 (reflected polynomial 0xEDB88320, as in zlib and Ethernet).
+std::uint32_t crc32_bitwise(bytes data);           // crc_bitwise.cpp: no table
+std::uint32_t crc32_runtime_table(bytes data);     // crc_runtime_table.cpp: table built on first call
+std::uint32_t crc32_constexpr_table(bytes data);   // crc_constexpr_table.cpp: table built by the compiler
+std::uint32_t crc32_constexpr_slice8(bytes data);  // crc_constexpr_slice8.cpp: 8 tables, 8 bytes per step
+
+// Base64 (RFC 4648, padded).  decode writes at most in.size() / 4 * 3 bytes
+// and returns how many, or -1 on malformed input.
+std::size_t base64_encode(bytes in, char* out);                              // base64_encode.cpp
+std::ptrdiff_t base64_decode_branchy(std::string_view in, std::uint8_t* out);  // base64_branchy.cpp
+std::ptrdiff_t base64_decode_constexpr(std::string_view in, std::uint8_t* out);  // base64_constexpr.cpp
+
+// Whether `word` is a C++20 keyword.
+bool is_keyword_unordered_set(std::string_view word);  // keywords_unordered_set.cpp
+bool is_keyword_sorted(std::string_view word);         // keywords_sorted.cpp: constexpr-sorted array
+bool is_keyword_perfect_hash(std::string_view word);   // keywords_perfect_hash.cpp
+
+// x = x * scale + 1, then optionally squared, negated and clamped to
+// [-1000, 1000], in place.
+struct transform_options {
+    float scale = 1.0f;
+    bool square = false;
+    bool negate = false;
+    bool clamp = false;
+};
+void transform_runtime(std::span<float> data, transform_options const& opt);            // loop_runtime.cpp
+void transform_runtime_no_unswitch(std::span<float> data, transform_options const& opt);  // loop_runtime_no_unswitch.cpp
+void transform_template(std::span<float> data, transform_options const& opt);           // loop_template.cpp
+
+}  // namespace specialization
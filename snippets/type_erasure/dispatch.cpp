@@ -0,0 +1,281 @@
+// One heterogeneous loop, summing the areas of `objects` shapes of four
+// types, through each way C++ offers to hold "one of several types":
+//
+//   virtual            std::vector<std::unique_ptr<shape>>, shapes allocated
+//                      in visiting order, so malloc lays them out in sequence
+//   virtual_scattered  the same, but allocated in shuffled order: a
+//                      long-lived heap where neighbours in the container were
+//                      not allocated together
+//   std_function       std::vector<std::function<double()>> of lambdas
+//                      capturing the shape; trapezoids do not fit the inline
+//                      buffer and are allocated
+//   variant            std::vector<std::variant<...>> and std::visit
+//   small_function     std::vector<small_function<double()>> (small_function.hpp),
+//                      every shape inline
+//   by_type            one vector per type and no dispatch at all, the floor
+//                      the others are measured against
+//
+// With `grouped:0` the types come in random order and every mechanism but
+// by_type pays for an indirect branch it cannot predict once the sequence is
+// too long for the predictor to learn (a few thousand objects); `grouped:1`
+// visits the same shapes in four runs of one type each, leaving the cost of
+// the call and of reaching the object.
+//
+// `allocs_per_object` and `bytes_per_object` count the heap allocations and
+// requested bytes of building the container, the container itself included;
+// malloc's per-chunk header comes on top, once per separately allocated
+// shape.  The label places that footprint in the cache hierarchy: while it
+// fits, the difference between the mechanisms is the dispatch itself; past
+// the last-level cache it is how many cache lines each object costs and
+// whether the hardware prefetcher can follow them.
+//
+// Every case checks its sum against a plain loop over the shape recipes.
+
+#include "shapes.hpp"
+#include "small_function.hpp"
+
+#include <cpplearn/alloc_counter.hpp>
+#include <cpplearn/bench.hpp>
+#include <cpplearn/perf_counters.hpp>
+
+#include <array>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace {
+
+namespace te = type_erasure;
+using cpplearn::bench::do_not_optimize;
+using cpplearn::bench::state;
+using te::shape_spec;
+
+constexpr auto shape_area = [](auto const& s) { return te::area(s); };
+
+struct virtual_calls {
+    using container = std::vector<std::unique_ptr<te::shape>>;
+
+    static std::unique_ptr<te::shape> make(shape_spec const& spec) {
+        return te::with_shape(spec, []<class S>(S s) -> std::unique_ptr<te::shape> {
+            return std::make_unique<te::shape_model<S>>(s);
+        });
+    }
+
+    static container build(std::vector<shape_spec> const& specs) {
+        container c;
+        c.reserve(specs.size());
+        for (auto const& spec : specs) {
+            c.push_back(make(spec));
+        }
+        return c;
+    }
+
+    static double total(container const& c) {
+        double sum = 0.0;
+        for (auto const& s : c) {
+            sum += s->area();
+        }
+        return sum;
+    }
+};
+
+struct virtual_scattered : virtual_calls {
+    // Same visiting order, but the shapes are allocated in a scrambled one:
+    // multiplying by an odd constant modulo a power of two (every `objects`
+    // value is one) reaches each index once, and needs no buffer that would
+    // show up in the allocation counters.
+    static container build(std::vector<shape_spec> const& specs) {
+        std::size_t const n = specs.size();
+        container c(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            std::size_t const j = (i * 0x9e3779b97f4a7c15ull) & (n - 1);
+            c[j] = make(specs[j]);
+        }
+        return c;
+    }
+};
+
+struct std_function {
+    using container = std::vector<std::function<double()>>;
+
+    static container build(std::vector<shape_spec> const& specs) {
+        container c;
+        c.reserve(specs.size());
+        for (auto const& spec : specs) {
+            c.push_back(te::with_shape(spec, [](auto s) -> std::function<double()> {
+                return [s] { return te::area(s); };
+            }));
+        }
+        return c;
+    }
+
+    static double total(container const& c) {
+        double sum = 0.0;
+        for (auto const& f : c) {
+            sum += f();
+        }
+        return sum;
+    }
+};
+
+struct variant {
+    using container = std::vector<te::shape_variant>;
+
+    static container build(std::vector<shape_spec> const& specs) {
+        container c;
+        c.reserve(specs.size());
+        for (auto const& spec : specs) {
+            c.push_back(te::with_shape(spec, [](auto s) -> te::shape_variant { return s; }));
+        }
+        return c;
+    }
+
+    static double total(container const& c) {
+        double sum = 0.0;
+        for (auto const& v : c) {
+            sum += std::visit(shape_area, v);
+        }
+        return sum;
+    }
+};
+
+struct small_function {
+    using container = std::vector<te::small_function<double()>>;
+
+    static container build(std::vector<shape_spec> const& specs) {
+        container c;
+        c.reserve(specs.size());
+        for (auto const& spec : specs) {
+            c.push_back(te::with_shape(spec, [](auto s) -> te::small_function<double()> {
+                return [s] { return te::area(s); };
+            }));
+        }
+        return c;
+    }
+
+    static double total(container const& c) {
+        double sum = 0.0;
+        for (auto const& f : c) {
+            sum += f();
+        }
+        return sum;
+    }
+};
+
+struct by_type {
+    struct container {
+        std::vector<te::circle> circles;
+        std::vector<te::square> squares;
+        std::vector<te::rectangle> rectangles;
+        std::vector<te::trapezoid> trapezoids;
+    };
+
+    static container build(std::vector<shape_spec> const& specs) {
+        std::array<std::size_t, 4> counts{};
+        for (auto const& spec : specs) {
+            ++counts[spec.kind];
+        }
+        container c;
+        c.circles.reserve(counts[0]);
+        c.squares.reserve(counts[1]);
+        c.rectangles.reserve(counts[2]);
+        c.trapezoids.reserve(counts[3]);
+        for (auto const& spec : specs) {
+            te::with_shape(spec, [&c](auto s) {
+                using S = decltype(s);
+                if constexpr (std::is_same_v<S, te::circle>) {
+                    c.circles.push_back(s);
+                } else if constexpr (std::is_same_v<S, te::square>) {
+                    c.squares.push_back(s);
+                } else if constexpr (std::is_same_v<S, te::rectangle>) {
+                    c.rectangles.push_back(s);
+                } else {
+                    c.trapezoids.push_back(s);
+                }
+            });
+        }
+        return c;
+    }
+
+    template <class S>
+    static double sum(std::vector<S> const& shapes) {
+        double sum = 0.0;
+        for (auto const& s : shapes) {
+            sum += te::area(s);
+        }
+        return sum;
+    }
+
+    static double total(container const& c) {
+        return sum(c.circles) + sum(c.squares) + sum(c.rectangles) + sum(c.trapezoids);
+    }
+};
+
+template <class Model>
+void bm_dispatch(state& st) {
+    auto const n = static_cast<std::size_t>(st.arg(0));
+    auto const specs = te::make_specs(n, st.arg(1) != 0);
+    double expected = 0.0;
+    for (auto const& spec : specs) {
+        expected += te::with_shape(spec, shape_area);
+    }
+
+    cpplearn::bench::alloc_scope allocs;
+    auto const objects = Model::build(specs);
+    auto const built = allocs.delta();
+
+    // Summation order differs between the models, so the sums may differ in
+    // the last bits.
+    if (std::abs(Model::total(objects) - expected) > 1e-9 * expected) {
+        st.error("sum of areas differs from the reference");
+        return;
+    }
+
+    cpplearn::bench::perf_counters counters;
+    counters.start();
+    for (auto _ : st) {
+        do_not_optimize(Model::total(objects));
+    }
+    counters.stop();
+
+    st.set_label(cpplearn::bench::cache_fit(built.bytes));
+    counters.report(st);
+    st.set_items_processed(st.iterations() * n);
+    st.set_counter("allocs_per_object", static_cast<double>(built.allocations) / static_cast<double>(n));
+    st.set_counter("bytes_per_object", static_cast<double>(built.bytes) / static_cast<double>(n));
+}
+
+std::vector<std::int64_t> object_counts() {
+    std::vector<std::int64_t> counts;
+    for (std::int64_t n = 1 << 8; n <= std::int64_t{1} << 22; n *= 4) {
+        counts.push_back(n);
+    }
+    return counts;
+}
+
+[[maybe_unused]] bool const registered = [] {
+    using cpplearn::bench::register_benchmark;
+    struct model {
+        char const* name;
+        void (*fn)(state&);
+    };
+    for (auto const& m : {model{"virtual", bm_dispatch<virtual_calls>},
+                          model{"virtual_scattered", bm_dispatch<virtual_scattered>},
+                          model{"std_function", bm_dispatch<std_function>}, model{"variant", bm_dispatch<variant>},
+                          model{"small_function", bm_dispatch<small_function>}}) {
+        register_benchmark(std::string{"dispatch/"} + m.name, m.fn)
+            ->args_product({object_counts(), {0, 1}})
+            ->arg_names({"objects", "grouped"});
+    }
+    // One vector per type is grouped by construction.
+    register_benchmark("dispatch/by_type", bm_dispatch<by_type>)
+        ->args_product({object_counts(), {1}})
+        ->arg_names({"objects", "grouped"});
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,105 @@
+// Four shapes, as plain value types, and the recipe every container in this
+// module is built from.
+//
+// The shapes differ in size on purpose: circle and square are 8 bytes,
+// rectangle 16 and trapezoid 24.  libstdc++'s std::function keeps callables
+// of up to 16 trivially copyable bytes inline, so a lambda holding a
+// trapezoid is the one that goes to the heap.
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <variant>
+#include <vector>
+
+namespace type_erasure {
+
+struct circle {
+    double radius;
+};
+
+struct square {
+    double side;
+};
+
+struct rectangle {
+    double width;
+    double height;
+};
+
+struct trapezoid {
+    double top;
+    double bottom;
+    double height;
+};
+
+inline double area(circle const& c) noexcept {
+    return 3.14159265358979323846 * c.radius * c.radius;
+}
+
+inline double area(square const& s) noexcept {
+    return s.side * s.side;
+}
+
+inline double area(rectangle const& r) noexcept {
+    return r.width * r.height;
+}
+
+inline double area(trapezoid const& t) noexcept {
+    return 0.5 * (t.top + t.bottom) * t.height;
+}
+
+// What to build, in which order.
+struct shape_spec {
+    std::uint8_t kind;  // 0 circle, 1 square, 2 rectangle, 3 trapezoid
+    double a;
+    double b;
+    double c;
+};
+
+// Kinds are drawn uniformly at random; `grouped` then sorts them into four
+// runs, which leaves the same shapes but makes the next type predictable.
+inline std::vector<shape_spec> make_specs(std::size_t n, bool grouped) {
+    std::mt19937_64 rng{17};
+    std::uniform_real_distribution<double> dim{1.0, 2.0};
+    std::vector<shape_spec> specs(n);
+    for (auto& s : specs) {
+        s = {static_cast<std::uint8_t>(rng() % 4), dim(rng), dim(rng), dim(rng)};
+    }
+    if (grouped) {
+        std::stable_sort(specs.begin(), specs.end(),
+                         [](shape_spec const& x, shape_spec const& y) { return x.kind < y.kind; });
+    }
+    return specs;
+}
+
+// Calls f with the shape `s` describes.
+template <class F>
+decltype(auto) with_shape(shape_spec const& s, F&& f) {
+    switch (s.kind) {
+    case 0: return f(circle{s.a});
+    case 1: return f(square{s.a});
+    case 2: return f(rectangle{s.a, s.b});
+    default: return f(trapezoid{s.a, s.b, s.c});
+    }
+}
+
+// Classic runtime polymorphism: one heap object per shape, reached through
+// a pointer and then through its vtable.
+struct shape {
+    virtual ~shape() = default;
+    virtual double area() const = 0;
+};
+
+template <class S>
+struct shape_model final : shape {
+    explicit shape_model(S s) : value{s} {}
+    double area() const override { return type_erasure::area(value); }
+    S value;
+};
+
+// A closed set of alternatives stored by value, 32 bytes each.
+using shape_variant = std::variant<circle, square, rectangle, trapezoid>;
+
+}  // namespace type_erasure
@@ -0,0 +1,127 @@
+// A move-only type-erased callable with an inline buffer.
+//
+//   small_function<double()> f = [s] { return area(s); };
+//
+// The callable lives in `Capacity` bytes inside the object, next to two
+// function pointers: one that invokes it and one that moves or destroys it.
+// A call is one load of `invoke_` and one indirect call, with the callable's
+// state on the same cache line, where a virtual call first follows the
+// object pointer and then the vtable pointer.  Callables that are too big,
+// over-aligned or not nothrow-movable are boxed on the heap, so anything
+// invocable still fits, at std::function's price.
+//
+// Unlike std::function it cannot be copied, which is what lets it hold
+// move-only callables and keeps the manager to two operations.
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace type_erasure {
+
+template <class Signature, std::size_t Capacity = 3 * sizeof(void*)>
+class small_function;
+
+template <class R, class... Args, std::size_t Capacity>
+class small_function<R(Args...), Capacity> {
+public:
+    template <class T>
+    static constexpr bool stored_inline = sizeof(T) <= Capacity && alignof(T) <= alignof(void*) &&
+                                          std::is_nothrow_move_constructible_v<T>;
+
+    small_function() noexcept = default;
+
+    template <class F>
+        requires(!std::is_same_v<std::decay_t<F>, small_function> &&
+                 std::is_invocable_r_v<R, std::decay_t<F> const&, Args...>)
+    small_function(F&& f) {  // implicit, like std::function
+        using T = std::decay_t<F>;
+        if constexpr (stored_inline<T>) {
+            ::new (static_cast<void*>(storage_)) T(std::forward<F>(f));
+        } else {
+            ::new (static_cast<void*>(storage_)) T*(new T(std::forward<F>(f)));
+        }
+        invoke_ = &invoke<T>;
+        manage_ = &manage<T>;
+    }
+
+    small_function(small_function&& other) noexcept { take(other); }
+
+    small_function& operator=(small_function&& other) noexcept {
+        if (this != &other) {
+            reset();
+            take(other);
+        }
+        return *this;
+    }
+
+    small_function(small_function const&) = delete;
+    small_function& operator=(small_function const&) = delete;
+
+    ~small_function() { reset(); }
+
+    R operator()(Args... args) const { return invoke_(storage_, std::forward<Args>(args)...); }
+
+    explicit operator bool() const noexcept { return invoke_ != nullptr; }
+
+private:
+    enum class operation { move, destroy };
+
+    template <class T>
+    static T const& target(std::byte const* storage) noexcept {
+        if constexpr (stored_inline<T>) {
+            return *std::launder(reinterpret_cast<T const*>(storage));
+        } else {
+            return **std::launder(reinterpret_cast<T* const*>(storage));
+        }
+    }
+
+    template <class T>
+    static R invoke(std::byte const* storage, Args&&... args) {
+        return std::invoke(target<T>(storage), std::forward<Args>(args)...);
+    }
+
+    // move: construct into `to` from `from`, then destroy `from`.
+    template <class T>
+    static void manage(operation op, std::byte* from, std::byte* to) noexcept {
+        if constexpr (stored_inline<T>) {
+            T* const p = std::launder(reinterpret_cast<T*>(from));
+            if (op == operation::move) {
+                ::new (static_cast<void*>(to)) T(std::move(*p));
+            }
+            p->~T();
+        } else {
+            T** const p = std::launder(reinterpret_cast<T**>(from));
+            if (op == operation::move) {
+                ::new (static_cast<void*>(to)) T*(*p);
+            } else {
+                delete *p;
+            }
+        }
+    }
+
+    void take(small_function& other) noexcept {
+        if (other.manage_ != nullptr) {
+            other.manage_(operation::move, other.storage_, storage_);
+        }
+        invoke_ = std::exchange(other.invoke_, nullptr);
+        manage_ = std::exchange(other.manage_, nullptr);
+    }
+
+    void reset() noexcept {
+        if (manage_ != nullptr) {
+            manage_(operation::destroy, storage_, nullptr);
+        }
+        invoke_ = nullptr;
+        manage_ = nullptr;
+    }
+
+    R (*invoke_)(std::byte const*, Args&&...) = nullptr;
+    void (*manage_)(operation, std::byte*, std::byte*) noexcept = nullptr;
+    alignas(void*) std::byte storage_[Capacity];
+};
+
+}  // namespace type_erasure